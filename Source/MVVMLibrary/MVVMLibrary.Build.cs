@@ -26,7 +26,7 @@ public class MVVMLibrary : ModuleRules
 			new string[]
 			{
 				"Core",
-				"UMG",
+				"DeveloperSettings",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -37,8 +37,6 @@ public class MVVMLibrary : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
-				"Slate",
-				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
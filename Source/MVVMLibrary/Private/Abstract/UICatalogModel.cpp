@@ -0,0 +1,490 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "Abstract/UICatalogModel.h"
+
+#include "Algo/Sort.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogUICatalogModel, Log, All);
+
+namespace UICatalogFormat
+{
+	constexpr uint32 FileMagic = 0x5443564D;
+	constexpr uint32 FileVersion = 1;
+
+	/** Start of every catalog file. Stored in the native byte order of the little-endian target platforms */
+	struct FHeader
+	{
+		uint32 Magic = FileMagic;
+		uint32 Version = FileVersion;
+		uint32 Layout = 0;
+		uint32 RecordStride = 0;
+		uint64 RecordCount = 0;
+		uint64 IndexOffset = 0;
+		uint64 DataOffset = 0;
+	};
+	static_assert(sizeof(FHeader) == 40, "Catalog header layout changed");
+
+	/** Entry of the sorted index of Indexed catalogs. Offset is relative to the data block */
+	struct FIndexEntry
+	{
+		int64 Id = 0;
+		uint64 Offset = 0;
+		uint32 Size = 0;
+		uint32 Reserved = 0;
+	};
+	static_assert(sizeof(FIndexEntry) == 24, "Catalog index layout changed");
+
+	void Append(TArray<uint8>& File, const void* Data, int64 Size)
+	{
+		File.Append(static_cast<const uint8*>(Data), static_cast<int32>(Size));
+	}
+}
+
+void UUICatalogModel::BeginDestroy()
+{
+	CloseCatalog();
+
+	Super::BeginDestroy();
+}
+
+const void* UUICatalogModel::FindRecord(int64 Id)
+{
+	if(!IsCatalogOpen()) return nullptr;
+
+	if(const int32* Slot = CachedRecordSlots.Find(Id))
+	{
+		TouchCachedRecord(*Slot);
+		return CachedRecords[*Slot].Memory;
+	}
+
+	const int32 Index = LowerBound(Id);
+	if(Index >= RecordCount || GetIdAt(Index) != Id) return nullptr;
+
+	//Reuse the least recently used slot once the cache is full
+	int32 Slot;
+	if(CachedRecords.Num() < FMath::Max(DecodedRecordCacheSize, 1))
+	{
+		Slot = CachedRecords.AddDefaulted();
+		CachedRecords[Slot].Memory = FMemory::Malloc(RecordType->GetStructureSize(), RecordType->GetMinAlignment());
+		RecordType->InitializeStruct(CachedRecords[Slot].Memory);
+	}
+	else
+	{
+		Slot = LeastRecentSlot;
+		UnlinkCachedRecord(Slot);
+		if(CachedRecords[Slot].bIsValid)
+		{
+			CachedRecordSlots.Remove(CachedRecords[Slot].Id);
+		}
+		RecordType->ClearScriptStruct(CachedRecords[Slot].Memory);
+	}
+
+	auto& CachedRecord = CachedRecords[Slot];
+	CachedRecord.Id = Id;
+	CachedRecord.bIsValid = DecodeRecord(Id, GetPayloadAt(Index), CachedRecord.Memory);
+	if(!CachedRecord.bIsValid)
+	{
+		UE_LOG(LogUICatalogModel, Warning, TEXT("Can not decode record %lld of catalog %s"), Id, *CatalogPath);
+
+		//A failed slot is the first one to be reused
+		CachedRecord.Prev = LeastRecentSlot;
+		if(LeastRecentSlot != INDEX_NONE) CachedRecords[LeastRecentSlot].Next = Slot;
+		LeastRecentSlot = Slot;
+		if(MostRecentSlot == INDEX_NONE) MostRecentSlot = Slot;
+		return nullptr;
+	}
+
+	CachedRecordSlots.Add(Id, Slot);
+	TouchCachedRecord(Slot);
+	return CachedRecord.Memory;
+}
+
+void UUICatalogModel::ForEachRecordInRange(int64 FirstId, int64 LastId, TFunctionRef<bool(int64 Id, const void* Record)> Callback)
+{
+	if(!IsCatalogOpen()) return;
+
+	for (int32 Index = LowerBound(FirstId); Index < RecordCount; ++Index)
+	{
+		const int64 Id = GetIdAt(Index);
+		if(Id > LastId) break;
+
+		const void* Record = FindRecord(Id);
+		if(Record && !Callback(Id, Record)) break;
+	}
+}
+
+bool UUICatalogModel::GetRecord(int64 Id, int32& OutRecord)
+{
+	//Never called: the custom thunk handles the wildcard struct
+	check(0);
+	return false;
+}
+
+TArray<int64> UUICatalogModel::GetRecordIdsInRange(int64 FirstId, int64 LastId, int32 MaxCount) const
+{
+	TArray<int64> Ids;
+	if(!IsCatalogOpen()) return Ids;
+
+	for (int32 Index = LowerBound(FirstId); Index < RecordCount && Ids.Num() < MaxCount; ++Index)
+	{
+		const int64 Id = GetIdAt(Index);
+		if(Id > LastId) break;
+		Ids.Add(Id);
+	}
+
+	return Ids;
+}
+
+bool UUICatalogModel::ContainsRecord(int64 Id) const
+{
+	if(!IsCatalogOpen()) return false;
+
+	const int32 Index = LowerBound(Id);
+	return Index < RecordCount && GetIdAt(Index) == Id;
+}
+
+int32 UUICatalogModel::GetRecordCount() const
+{
+	return RecordCount;
+}
+
+bool UUICatalogModel::IsCatalogOpen() const
+{
+	return MappedData != nullptr || FileHandle.IsValid();
+}
+
+bool UUICatalogModel::WriteCatalogFile(const FString& FilePath, const UScriptStruct* InRecordType, TConstArrayView<int64> Ids,
+	TConstArrayView<const void*> Records, ECatalogLayout Layout)
+{
+	if(!InRecordType || Ids.Num() != Records.Num()) return false;
+
+	TArray<int32> Order;
+	Order.Reserve(Ids.Num());
+	for (int32 Index = 0; Index < Ids.Num(); ++Index)
+	{
+		Order.Add(Index);
+	}
+	Algo::Sort(Order, [&Ids](int32 A, int32 B)
+	{
+		return Ids[A] < Ids[B];
+	});
+
+	TArray<TArray<uint8>> Payloads;
+	Payloads.Reserve(Order.Num());
+	int64 MaxPayloadSize = 0;
+	for (int32 Position = 0; Position < Order.Num(); ++Position)
+	{
+		if(Position > 0 && Ids[Order[Position]] == Ids[Order[Position - 1]])
+		{
+			UE_LOG(LogUICatalogModel, Error, TEXT("Catalog %s has duplicate record id %lld"), *FilePath, Ids[Order[Position]]);
+			return false;
+		}
+
+		auto& Payload = Payloads.AddDefaulted_GetRef();
+		FMemoryWriter Writer(Payload);
+		InRecordType->SerializeBin(Writer, const_cast<void*>(Records[Order[Position]]));
+		MaxPayloadSize = FMath::Max<int64>(MaxPayloadSize, Payload.Num());
+	}
+
+	UICatalogFormat::FHeader Header;
+	Header.Layout = static_cast<uint32>(Layout);
+	Header.RecordCount = Order.Num();
+
+	TArray<uint8> File;
+	if(Layout == ECatalogLayout::FixedStride)
+	{
+		Header.RecordStride = static_cast<uint32>(Align(sizeof(int64) + MaxPayloadSize, sizeof(int64)));
+		Header.DataOffset = sizeof(Header);
+		File.Reserve(static_cast<int32>(Header.DataOffset + Header.RecordCount * Header.RecordStride));
+		UICatalogFormat::Append(File, &Header, sizeof(Header));
+
+		for (int32 Position = 0; Position < Order.Num(); ++Position)
+		{
+			const int64 Id = Ids[Order[Position]];
+			UICatalogFormat::Append(File, &Id, sizeof(Id));
+			File.Append(Payloads[Position]);
+			File.AddZeroed(static_cast<int32>(Header.RecordStride - sizeof(Id)) - Payloads[Position].Num());
+		}
+	}
+	else
+	{
+		Header.IndexOffset = sizeof(Header);
+		Header.DataOffset = Header.IndexOffset + Header.RecordCount * sizeof(UICatalogFormat::FIndexEntry);
+		UICatalogFormat::Append(File, &Header, sizeof(Header));
+
+		uint64 Offset = 0;
+		for (int32 Position = 0; Position < Order.Num(); ++Position)
+		{
+			UICatalogFormat::FIndexEntry Entry;
+			Entry.Id = Ids[Order[Position]];
+			Entry.Offset = Offset;
+			Entry.Size = static_cast<uint32>(Payloads[Position].Num());
+			UICatalogFormat::Append(File, &Entry, sizeof(Entry));
+			Offset += Entry.Size;
+		}
+
+		for (const auto& Payload : Payloads)
+		{
+			File.Append(Payload);
+		}
+	}
+
+	return FFileHelper::SaveArrayToFile(File, *FilePath);
+}
+
+void UUICatalogModel::StartSession()
+{
+	OpenCatalog();
+
+	Super::StartSession();
+}
+
+void UUICatalogModel::EndSession()
+{
+	Super::EndSession();
+
+	CloseCatalog();
+}
+
+bool UUICatalogModel::DecodeRecord(int64 Id, TConstArrayView<uint8> Bytes, void* OutRecord) const
+{
+	FMemoryReaderView Reader(Bytes);
+	RecordType->SerializeBin(Reader, OutRecord);
+	return !Reader.IsError();
+}
+
+bool UUICatalogModel::OpenCatalog()
+{
+	CloseCatalog();
+
+	if(CatalogPath.IsEmpty() || !RecordType)
+	{
+		UE_LOG(LogUICatalogModel, Warning, TEXT("%s has no catalog path or record type"), *GetNameSafe(GetClass()));
+		return false;
+	}
+
+	const FString FullPath = FPaths::ProjectContentDir() / CatalogPath;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	//Map the whole file: the OS pages records in when they are read
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*FullPath);
+	if(MappedResult.HasValue())
+	{
+		MappedFile = MappedResult.StealValue();
+		FileSize = MappedFile->GetFileSize();
+		MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+		MappedData = MappedRegion ? MappedRegion->GetMappedPtr() : nullptr;
+	}
+
+	//Files inside a pak can not be mapped
+	if(!MappedData)
+	{
+		MappedRegion.Reset();
+		MappedFile.Reset();
+		FileHandle.Reset(PlatformFile.OpenRead(*FullPath));
+		if(!FileHandle)
+		{
+			UE_LOG(LogUICatalogModel, Error, TEXT("Can not open catalog %s"), *FullPath);
+			return false;
+		}
+		FileSize = FileHandle->Size();
+	}
+
+	UICatalogFormat::FHeader Header;
+	const bool bHasHeader = FileSize >= sizeof(Header) && ReadBytes(0, &Header, sizeof(Header));
+	const bool bIsSupported = bHasHeader
+		&& Header.Magic == UICatalogFormat::FileMagic
+		&& Header.Version == UICatalogFormat::FileVersion
+		&& Header.Layout <= static_cast<uint32>(ECatalogLayout::Indexed)
+		&& Header.RecordCount <= MAX_int32;
+
+	bool bFits = false;
+	if(bIsSupported && Header.Layout == static_cast<uint32>(ECatalogLayout::FixedStride))
+	{
+		bFits = Header.RecordStride >= sizeof(int64) && Header.DataOffset + Header.RecordCount * Header.RecordStride <= FileSize;
+	}
+	else if(bIsSupported)
+	{
+		bFits = Header.IndexOffset + Header.RecordCount * sizeof(UICatalogFormat::FIndexEntry) <= FileSize && Header.DataOffset <= FileSize;
+	}
+
+	if(!bFits)
+	{
+		UE_LOG(LogUICatalogModel, Error, TEXT("%s is not a valid catalog file"), *FullPath);
+		CloseCatalog();
+		return false;
+	}
+
+	Layout = static_cast<ECatalogLayout>(Header.Layout);
+	RecordStride = Header.RecordStride;
+	RecordCount = static_cast<int32>(Header.RecordCount);
+	IndexOffset = Header.IndexOffset;
+	DataOffset = Header.DataOffset;
+
+	return true;
+}
+
+void UUICatalogModel::CloseCatalog()
+{
+	EmptyCache();
+
+	MappedData = nullptr;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FileHandle.Reset();
+	FileSize = 0;
+	RecordCount = 0;
+	ReadBuffer.Empty();
+}
+
+DEFINE_FUNCTION(UUICatalogModel::execGetRecord)
+{
+	P_GET_PROPERTY(FInt64Property, Id);
+
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	void* ValuePtr = Stack.MostRecentPropertyAddress;
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	bool bResult = false;
+	if(ValueProperty && ValuePtr && ValueProperty->Struct == P_THIS->RecordType)
+	{
+		if(const void* Record = P_THIS->FindRecord(Id))
+		{
+			P_THIS->RecordType->CopyScriptStruct(ValuePtr, Record);
+			bResult = true;
+		}
+	}
+	else
+	{
+		FFrame::KismetExecutionMessage(TEXT("Record pin must match the record type of the catalog"), ELogVerbosity::Warning);
+	}
+	*static_cast<bool*>(RESULT_PARAM) = bResult;
+	P_NATIVE_END;
+}
+
+int32 UUICatalogModel::LowerBound(int64 Id) const
+{
+	int32 First = 0;
+	int32 Count = RecordCount;
+	while(Count > 0)
+	{
+		const int32 Step = Count / 2;
+		if(GetIdAt(First + Step) < Id)
+		{
+			First += Step + 1;
+			Count -= Step + 1;
+		}
+		else
+		{
+			Count = Step;
+		}
+	}
+
+	return First;
+}
+
+int64 UUICatalogModel::GetIdAt(int32 Index) const
+{
+	const uint64 Offset = Layout == ECatalogLayout::FixedStride
+		? DataOffset + static_cast<uint64>(Index) * RecordStride
+		: IndexOffset + static_cast<uint64>(Index) * sizeof(UICatalogFormat::FIndexEntry);
+
+	int64 Id = 0;
+	ReadBytes(Offset, &Id, sizeof(Id));
+	return Id;
+}
+
+TConstArrayView<uint8> UUICatalogModel::GetPayloadAt(int32 Index)
+{
+	uint64 Offset;
+	int64 Size;
+	if(Layout == ECatalogLayout::FixedStride)
+	{
+		Offset = DataOffset + static_cast<uint64>(Index) * RecordStride + sizeof(int64);
+		Size = RecordStride - sizeof(int64);
+	}
+	else
+	{
+		UICatalogFormat::FIndexEntry Entry;
+		ReadBytes(IndexOffset + static_cast<uint64>(Index) * sizeof(Entry), &Entry, sizeof(Entry));
+		Offset = DataOffset + Entry.Offset;
+		Size = Entry.Size;
+	}
+
+	if(Offset + Size > FileSize) return TConstArrayView<uint8>();
+
+	if(MappedData)
+	{
+		return TConstArrayView<uint8>(MappedData + Offset, static_cast<int32>(Size));
+	}
+
+	ReadBuffer.SetNumUninitialized(static_cast<int32>(Size));
+	return ReadBytes(Offset, ReadBuffer.GetData(), Size) ? TConstArrayView<uint8>(ReadBuffer) : TConstArrayView<uint8>();
+}
+
+bool UUICatalogModel::ReadBytes(uint64 Offset, void* Destination, int64 Size) const
+{
+	if(Offset + Size > FileSize) return false;
+
+	//Records are not aligned in the file, so values are copied out instead of read in place
+	if(MappedData)
+	{
+		FMemory::Memcpy(Destination, MappedData + Offset, Size);
+		return true;
+	}
+
+	return FileHandle && FileHandle->Seek(Offset) && FileHandle->Read(static_cast<uint8*>(Destination), Size);
+}
+
+void UUICatalogModel::TouchCachedRecord(int32 Slot)
+{
+	UnlinkCachedRecord(Slot);
+
+	auto& CachedRecord = CachedRecords[Slot];
+	CachedRecord.Next = MostRecentSlot;
+	if(MostRecentSlot != INDEX_NONE) CachedRecords[MostRecentSlot].Prev = Slot;
+	MostRecentSlot = Slot;
+	if(LeastRecentSlot == INDEX_NONE) LeastRecentSlot = Slot;
+}
+
+void UUICatalogModel::UnlinkCachedRecord(int32 Slot)
+{
+	auto& CachedRecord = CachedRecords[Slot];
+	if(CachedRecord.Prev != INDEX_NONE) CachedRecords[CachedRecord.Prev].Next = CachedRecord.Next;
+	else if(MostRecentSlot == Slot) MostRecentSlot = CachedRecord.Next;
+
+	if(CachedRecord.Next != INDEX_NONE) CachedRecords[CachedRecord.Next].Prev = CachedRecord.Prev;
+	else if(LeastRecentSlot == Slot) LeastRecentSlot = CachedRecord.Prev;
+
+	CachedRecord.Prev = INDEX_NONE;
+	CachedRecord.Next = INDEX_NONE;
+}
+
+void UUICatalogModel::EmptyCache()
+{
+	for (auto& CachedRecord : CachedRecords)
+	{
+		if(RecordType)
+		{
+			RecordType->DestroyStruct(CachedRecord.Memory);
+		}
+		FMemory::Free(CachedRecord.Memory);
+	}
+
+	CachedRecords.Empty();
+	CachedRecordSlots.Empty();
+	MostRecentSlot = INDEX_NONE;
+	LeastRecentSlot = INDEX_NONE;
+}
@@ -5,8 +5,25 @@
 
 
 #include "Abstract/UIContextualModel.h"
+#include "BlueprintEventMask.h"
 #include "WorldModelRepositorySubsystem.h"
 #include "ModelRepositorySubsystem.h"
+#include "ModelMutationRecorderSubsystem.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "GameFramework/Actor.h"
+
+namespace UIContextualModelEvents
+{
+	/** Index of the event in the name table of IsImplementedInBlueprint, which is also its bit in the mask */
+	enum EEvent : uint32
+	{
+		SetWorldModelRepository,
+		SetModelRepository,
+		OnInitModel,
+		OnDestroyModel,
+		Num
+	};
+}
 
 UWorldModelRepositorySubsystem* UUIContextualModel::GetWorldModelRepository() const
 {
@@ -18,24 +35,73 @@ UModelRepositorySubsystem* UUIContextualModel::GetModelRepository() const
 	return ModelRepository.IsValid() ? ModelRepository.Get() : nullptr;
 }
 
+int64 UUIContextualModel::GetEntityKey() const
+{
+	return static_cast<int64>(EntityKey);
+}
+
+AActor* UUIContextualModel::GetEntityActor() const
+{
+	return EntityActor.IsValid() ? EntityActor.Get() : nullptr;
+}
+
+void UUIContextualModel::NotifyFieldChanged(FName FieldName)
+{
+	UModelMutationRecorderSubsystem::RecordFieldChange(this, FieldName);
+	
+	OnFieldChanged.Broadcast(FieldName);
+}
+
+int64 UUIContextualModel::GetEstimatedMemorySize() const
+{
+	FArchiveCountMem CountMem(const_cast<UUIContextualModel*>(this));
+	return static_cast<int64>(CountMem.GetMax());
+}
+
 void UUIContextualModel::SetWorldModelRepository(UWorldModelRepositorySubsystem* InWorldModelRepository)
 {
 	WorldModelRepository = InWorldModelRepository;
-	K2_SetWorldModelRepository(InWorldModelRepository);
+	if(IsImplementedInBlueprint(UIContextualModelEvents::SetWorldModelRepository))
+	{
+		K2_SetWorldModelRepository(InWorldModelRepository);
+	}
 }
 
 void UUIContextualModel::SetModelRepository(UModelRepositorySubsystem* InModelRepository)
 {
 	ModelRepository = InModelRepository;
-	K2_SetModelRepository(InModelRepository);
+	if(IsImplementedInBlueprint(UIContextualModelEvents::SetModelRepository))
+	{
+		K2_SetModelRepository(InModelRepository);
+	}
 }
 
 void UUIContextualModel::OnInitModel()
 {
-	K2_OnInitModel();
+	if(IsImplementedInBlueprint(UIContextualModelEvents::OnInitModel))
+	{
+		K2_OnInitModel();
+	}
 }
 
 void UUIContextualModel::OnDestroyModel()
 {
-	K2_OnDestroyModel();
-}
\ No newline at end of file
+	if(IsImplementedInBlueprint(UIContextualModelEvents::OnDestroyModel))
+	{
+		K2_OnDestroyModel();
+	}
+}
+
+bool UUIContextualModel::IsImplementedInBlueprint(uint32 Event)
+{
+	static const FName EventNames[] =
+	{
+		GET_FUNCTION_NAME_CHECKED(UUIContextualModel, K2_SetWorldModelRepository),
+		GET_FUNCTION_NAME_CHECKED(UUIContextualModel, K2_SetModelRepository),
+		GET_FUNCTION_NAME_CHECKED(UUIContextualModel, K2_OnInitModel),
+		GET_FUNCTION_NAME_CHECKED(UUIContextualModel, K2_OnDestroyModel),
+	};
+	static_assert(UE_ARRAY_COUNT(EventNames) == UIContextualModelEvents::Num, "Every event needs a name, in EEvent order");
+
+	return FBlueprintEventMask::IsImplemented(ImplementedBlueprintEvents, GetClass(), EventNames, Event);
+}
@@ -5,25 +5,88 @@
 
 
 #include "Abstract/UISessionModel.h"
+#include "BlueprintEventMask.h"
 #include "ModelRepositorySubsystem.h"
+#include "ModelMutationRecorderSubsystem.h"
+
+namespace UISessionModelEvents
+{
+	/** Index of the event in the name table of IsImplementedInBlueprint, which is also its bit in the mask */
+	enum EEvent : uint32
+	{
+		SetModelRepository,
+		StartSession,
+		EndSession,
+		Num
+	};
+}
 
 UModelRepositorySubsystem* UUISessionModel::GetModelRepository() const
 {
 	return ModelRepository.IsValid() ? ModelRepository.Get() : nullptr;
 }
 
+void UUISessionModel::NotifyFieldChanged(FName FieldName)
+{
+	UModelMutationRecorderSubsystem::RecordFieldChange(this, FieldName);
+
+	switch (SnapshotPolicy)
+	{
+	case EModelSnapshotPolicy::OnChange:
+		PublishSnapshot();
+		break;
+	case EModelSnapshotPolicy::EndOfFrame:
+		if(!bIsSnapshotDirty && ModelRepository.IsValid())
+		{
+			bIsSnapshotDirty = true;
+			ModelRepository->MarkSnapshotDirty(this);
+		}
+		break;
+	default:
+		break;
+	}
+	
+	OnFieldChanged.Broadcast(FieldName);
+}
+
 void UUISessionModel::SetModelRepository(UModelRepositorySubsystem* InModelRepository)
 {
 	ModelRepository = InModelRepository;
-	K2_SetModelRepository(InModelRepository);
+	if(IsImplementedInBlueprint(UISessionModelEvents::SetModelRepository))
+	{
+		K2_SetModelRepository(InModelRepository);
+	}
 }
 
 void UUISessionModel::StartSession()
 {
-	K2_StartSession();
+	if(IsImplementedInBlueprint(UISessionModelEvents::StartSession))
+	{
+		K2_StartSession();
+	}
+}
+
+void UUISessionModel::PublishSnapshot()
+{
 }
 
 void UUISessionModel::EndSession()
 {
-	K2_EndSession();
+	if(IsImplementedInBlueprint(UISessionModelEvents::EndSession))
+	{
+		K2_EndSession();
+	}
+}
+
+bool UUISessionModel::IsImplementedInBlueprint(uint32 Event)
+{
+	static const FName EventNames[] =
+	{
+		GET_FUNCTION_NAME_CHECKED(UUISessionModel, K2_SetModelRepository),
+		GET_FUNCTION_NAME_CHECKED(UUISessionModel, K2_StartSession),
+		GET_FUNCTION_NAME_CHECKED(UUISessionModel, K2_EndSession),
+	};
+	static_assert(UE_ARRAY_COUNT(EventNames) == UISessionModelEvents::Num, "Every event needs a name, in EEvent order");
+
+	return FBlueprintEventMask::IsImplemented(ImplementedBlueprintEvents, GetClass(), EventNames, Event);
 }
@@ -0,0 +1,43 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "BlueprintEventMask.h"
+
+TMap<TPair<FObjectKey, const FName*>, uint32> FBlueprintEventMask::CachedMasks;
+
+uint32 FBlueprintEventMask::Get(const UClass* Class, TConstArrayView<FName> EventNames)
+{
+	check(IsInGameThread());
+	check(EventNames.Num() <= 32);
+	
+	if(!Class) return 0;
+
+	const TPair<FObjectKey, const FName*> Key(FObjectKey(Class), EventNames.GetData());
+	if(const auto CachedMask = CachedMasks.Find(Key))
+	{
+		return *CachedMask;
+	}
+
+	uint32 Mask = 0;
+	for (int32 Index = 0; Index < EventNames.Num(); ++Index)
+	{
+		if(Class->IsFunctionImplementedInScript(EventNames[Index]))
+		{
+			Mask |= 1u << Index;
+		}
+	}
+
+#if WITH_EDITOR
+	//Blueprint classes can be recompiled in the editor, so only native classes are cached there
+	if(Class->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
+	{
+		return Mask;
+	}
+#endif
+
+	CachedMasks.Add(Key, Mask);
+	return Mask;
+}
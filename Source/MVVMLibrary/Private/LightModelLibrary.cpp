@@ -0,0 +1,123 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "LightModelLibrary.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "ModelRepositorySubsystem.h"
+#include "WorldModelRepositorySubsystem.h"
+
+namespace LightModelLibrary
+{
+	FUILightModel* GetLightModel(const UObject* WorldContextObject, ELightModelScope Scope, const UScriptStruct* ModelType, uint64 Key)
+	{
+		const auto World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+		if(!World) return nullptr;
+
+		if(Scope == ELightModelScope::World)
+		{
+			const auto WorldModelRepository = World->GetSubsystem<UWorldModelRepositorySubsystem>();
+			return WorldModelRepository ? WorldModelRepository->GetLightModels().Get(ModelType, Key) : nullptr;
+		}
+
+		const auto GameInstance = World->GetGameInstance();
+		const auto ModelRepository = GameInstance ? GameInstance->GetSubsystem<UModelRepositorySubsystem>() : nullptr;
+		return ModelRepository ? ModelRepository->GetLightModels().Get(ModelType, Key) : nullptr;
+	}
+}
+
+bool ULightModelLibrary::GetLightModel(const UObject* WorldContextObject, ELightModelScope Scope, int64 Key, int32& OutModel)
+{
+	//Never called: the custom thunk handles the wildcard struct
+	check(0);
+	return false;
+}
+
+bool ULightModelLibrary::SetLightModel(const UObject* WorldContextObject, ELightModelScope Scope, int64 Key, const int32& Model)
+{
+	//Never called: the custom thunk handles the wildcard struct
+	check(0);
+	return false;
+}
+
+bool ULightModelLibrary::DestroyLightModel(const UObject* WorldContextObject, ELightModelScope Scope, UScriptStruct* ModelType, int64 Key)
+{
+	const auto World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	if(!World || !ModelType) return false;
+
+	if(Scope == ELightModelScope::World)
+	{
+		const auto WorldModelRepository = World->GetSubsystem<UWorldModelRepositorySubsystem>();
+		return WorldModelRepository && WorldModelRepository->GetLightModels().Remove(ModelType, static_cast<uint64>(Key));
+	}
+
+	const auto GameInstance = World->GetGameInstance();
+	const auto ModelRepository = GameInstance ? GameInstance->GetSubsystem<UModelRepositorySubsystem>() : nullptr;
+	return ModelRepository && ModelRepository->GetLightModels().Remove(ModelType, static_cast<uint64>(Key));
+}
+
+DEFINE_FUNCTION(ULightModelLibrary::execGetLightModel)
+{
+	P_GET_OBJECT(UObject, WorldContextObject);
+	P_GET_ENUM(ELightModelScope, Scope);
+	P_GET_PROPERTY(FInt64Property, Key);
+
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	void* ValuePtr = Stack.MostRecentPropertyAddress;
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	*static_cast<bool*>(RESULT_PARAM) = CopyLightModel(WorldContextObject, Scope, static_cast<uint64>(Key), ValueProperty, ValuePtr, true);
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(ULightModelLibrary::execSetLightModel)
+{
+	P_GET_OBJECT(UObject, WorldContextObject);
+	P_GET_ENUM(ELightModelScope, Scope);
+	P_GET_PROPERTY(FInt64Property, Key);
+
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	void* ValuePtr = Stack.MostRecentPropertyAddress;
+	const FStructProperty* ValueProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	*static_cast<bool*>(RESULT_PARAM) = CopyLightModel(WorldContextObject, Scope, static_cast<uint64>(Key), ValueProperty, ValuePtr, false);
+	P_NATIVE_END;
+}
+
+bool ULightModelLibrary::CopyLightModel(const UObject* WorldContextObject, ELightModelScope Scope, uint64 Key,
+                                        const FStructProperty* ValueProperty, void* Value, bool bRead)
+{
+	if(!ValueProperty || !Value) return false;
+
+	const UScriptStruct* ModelType = ValueProperty->Struct;
+	if(!ModelType || !ModelType->IsChildOf(FUILightModel::StaticStruct()))
+	{
+		FFrame::KismetExecutionMessage(TEXT("Light model pin must be an heir of FUILightModel"), ELogVerbosity::Warning);
+		return false;
+	}
+
+	FUILightModel* Model = LightModelLibrary::GetLightModel(WorldContextObject, Scope, ModelType, Key);
+	if(!Model) return false;
+
+	if(bRead)
+	{
+		ModelType->CopyScriptStruct(Value, Model);
+	}
+	else
+	{
+		ModelType->CopyScriptStruct(Model, Value);
+	}
+
+	return true;
+}
@@ -0,0 +1,181 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "LightModelStorage.h"
+
+#include "MVVMHitchTracker.h"
+
+FLightModelStorage::~FLightModelStorage()
+{
+	Empty();
+}
+
+void FLightModelStorage::SetContext(UModelRepositorySubsystem* ModelRepository, UWorldModelRepositorySubsystem* WorldModelRepository)
+{
+	Context.ModelRepository = ModelRepository;
+	Context.WorldModelRepository = WorldModelRepository;
+}
+
+FUILightModel* FLightModelStorage::Get(const UScriptStruct* ModelType, uint64 Key)
+{
+	bool bCreated = false;
+	FUILightModel* Model = FindOrAdd(ModelType, Key, bCreated);
+	if(bCreated)
+	{
+		FUILightModelContext InitContext = Context;
+		InitContext.Key = Key;
+		{
+			MVVM_HITCH_SCOPE(ModelInitialization, ModelType);
+			Model->OnInitModel(InitContext);
+		}
+
+		//The hook may have created or destroyed models of the type, which moves them
+		return Find(ModelType, Key);
+	}
+
+	return Model;
+}
+
+FUILightModel* FLightModelStorage::Find(const UScriptStruct* ModelType, uint64 Key)
+{
+	const auto Bucket = Buckets.Find(FObjectKey(ModelType));
+	const int32* Index = Bucket ? Bucket->KeyToIndex.Find(Key) : nullptr;
+	return Index ? Bucket->GetModel(*Index) : nullptr;
+}
+
+FUILightModel* FLightModelStorage::FindOrAdd(const UScriptStruct* ModelType, uint64 Key, bool& bOutCreated)
+{
+	bOutCreated = false;
+
+	const auto Bucket = FindOrAddBucket(ModelType);
+	if(!Bucket) return nullptr;
+
+	if(const int32* Index = Bucket->KeyToIndex.Find(Key))
+	{
+		return Bucket->GetModel(*Index);
+	}
+
+	//Models are relocated bitwise on growth, like every other element of engine containers
+	const int32 Index = Bucket->Keys.Add(Key);
+	Bucket->Memory.AddUninitialized(Bucket->Stride);
+	Bucket->KeyToIndex.Add(Key, Index);
+
+	FUILightModel* Model = Bucket->GetModel(Index);
+	ModelType->InitializeStruct(Model);
+	bOutCreated = true;
+
+	return Model;
+}
+
+bool FLightModelStorage::Remove(const UScriptStruct* ModelType, uint64 Key)
+{
+	const auto Bucket = Buckets.Find(FObjectKey(ModelType));
+	const int32* Index = Bucket ? Bucket->KeyToIndex.Find(Key) : nullptr;
+	if(!Index) return false;
+
+	RemoveAt(*Bucket, *Index);
+	return true;
+}
+
+void FLightModelStorage::Empty()
+{
+	//The buckets are unlinked before any OnDestroyModel runs, so a hook that creates or destroys models never touches them.
+	//Models created by the hooks are destroyed by the next pass
+	while(Buckets.Num() > 0)
+	{
+		TMap<FObjectKey, FBucket> DestroyedBuckets = MoveTemp(Buckets);
+		Buckets.Reset();
+
+		for (auto& [ModelTypeKey, Bucket] : DestroyedBuckets)
+		{
+			for (int32 Index = 0; Index < Bucket.Keys.Num(); ++Index)
+			{
+				FUILightModel* Model = Bucket.GetModel(Index);
+				Model->OnDestroyModel();
+				//The type may already be gone on shutdown; the models are plain memory then
+				if(ModelTypeKey.ResolveObjectPtr())
+				{
+					Bucket.ModelType->DestroyStruct(Model);
+				}
+			}
+		}
+	}
+}
+
+int32 FLightModelStorage::Num(const UScriptStruct* ModelType) const
+{
+	const auto Bucket = Buckets.Find(FObjectKey(ModelType));
+	return Bucket ? Bucket->Keys.Num() : 0;
+}
+
+void FLightModelStorage::ForEach(const UScriptStruct* ModelType, TFunctionRef<void(uint64 Key, FUILightModel& Model)> Callback)
+{
+	const auto Bucket = Buckets.Find(FObjectKey(ModelType));
+	if(!Bucket) return;
+
+	for (int32 Index = 0; Index < Bucket->Keys.Num(); ++Index)
+	{
+		Callback(Bucket->Keys[Index], *Bucket->GetModel(Index));
+	}
+}
+
+FLightModelStorage::FBucket* FLightModelStorage::FindOrAddBucket(const UScriptStruct* ModelType)
+{
+	if(!ModelType) return nullptr;
+
+	const FObjectKey ModelTypeKey(ModelType);
+	if(const auto Bucket = Buckets.Find(ModelTypeKey))
+	{
+		return Bucket;
+	}
+
+	if(!ensureMsgf(ModelType->IsChildOf(FUILightModel::StaticStruct()), TEXT("%s is not a light model"), *ModelType->GetName())
+		|| !ensureMsgf(ModelType->GetMinAlignment() <= 16, TEXT("Light model %s is over-aligned"), *ModelType->GetName()))
+	{
+		return nullptr;
+	}
+
+#if DO_ENSURE
+	//Light models are invisible to GC, a strong reference inside would dangle
+	TArray<const FStructProperty*> EncounteredStructProps;
+	for (TFieldIterator<FProperty> It(ModelType); It; ++It)
+	{
+		ensureMsgf(!It->ContainsObjectReference(EncounteredStructProps, EPropertyObjectReferenceType::Strong),
+			TEXT("Light model %s holds a strong object reference in %s"), *ModelType->GetName(), *It->GetName());
+	}
+#endif
+
+	auto& Bucket = Buckets.Add(ModelTypeKey);
+	Bucket.ModelType = ModelType;
+	Bucket.Stride = Align(ModelType->GetStructureSize(), ModelType->GetMinAlignment());
+	return &Bucket;
+}
+
+void FLightModelStorage::RemoveAt(FBucket& Bucket, int32 Index)
+{
+	//The model is moved out and unlinked before OnDestroyModel runs: the hook may create or destroy models,
+	//which relocates the bucket or rehashes Buckets
+	const UScriptStruct* ModelType = Bucket.ModelType;
+	TArray<uint8, TAlignedHeapAllocator<16>> RemovedModel;
+	RemovedModel.SetNumUninitialized(Bucket.Stride);
+	FMemory::Memcpy(RemovedModel.GetData(), Bucket.GetModel(Index), Bucket.Stride);
+
+	const int32 LastIndex = Bucket.Keys.Num() - 1;
+	Bucket.KeyToIndex.Remove(Bucket.Keys[Index]);
+	if(Index != LastIndex)
+	{
+		FMemory::Memcpy(Bucket.GetModel(Index), Bucket.GetModel(LastIndex), Bucket.Stride);
+		Bucket.Keys[Index] = Bucket.Keys[LastIndex];
+		Bucket.KeyToIndex[Bucket.Keys[Index]] = Index;
+	}
+
+	Bucket.Keys.Pop();
+	Bucket.Memory.SetNum(LastIndex * Bucket.Stride);
+
+	FUILightModel* Model = reinterpret_cast<FUILightModel*>(RemovedModel.GetData());
+	Model->OnDestroyModel();
+	ModelType->DestroyStruct(Model);
+}
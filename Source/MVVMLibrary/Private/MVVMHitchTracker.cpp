@@ -0,0 +1,226 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "MVVMHitchTracker.h"
+
+#include "MVVMLibrarySettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+const TCHAR* LexToString(EMVVMWorkType WorkType)
+{
+	switch (WorkType)
+	{
+	case EMVVMWorkType::ViewCreation:        return TEXT("ViewCreation");
+	case EMVVMWorkType::ViewInitialization:  return TEXT("ViewInitialization");
+	case EMVVMWorkType::ViewModelCreation:   return TEXT("ViewModelCreation");
+	case EMVVMWorkType::ModelCreation:       return TEXT("ModelCreation");
+	case EMVVMWorkType::ModelInitialization: return TEXT("ModelInitialization");
+	case EMVVMWorkType::Teardown:            return TEXT("Teardown");
+	default:                                 return TEXT("Unknown");
+	}
+}
+
+#if WITH_MVVM_HITCH_TRACKER
+
+DEFINE_LOG_CATEGORY_STATIC(LogMVVMHitch, Log, All);
+
+namespace MVVMHitchTracking
+{
+	/** Classes listed in a hitch log line */
+	constexpr int32 MaxLoggedSamples = 5;
+
+	FAutoConsoleCommand DumpCsvCommand(
+		TEXT("MVVM.Hitch.DumpCsv"),
+		TEXT("Writes the per-class MVVM hitch histograms to CSV. Usage: MVVM.Hitch.DumpCsv [File]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if(const auto Tracker = FMVVMHitchTracker::Get())
+			{
+				Tracker->DumpCsv(Args.IsValidIndex(0) ? Args[0] : FString());
+			}
+		}));
+
+	FAutoConsoleCommand ResetCommand(
+		TEXT("MVVM.Hitch.Reset"),
+		TEXT("Clears the per-class MVVM hitch histograms."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if(const auto Tracker = FMVVMHitchTracker::Get())
+			{
+				Tracker->ResetHistograms();
+			}
+		}));
+}
+
+FMVVMHitchTracker* FMVVMHitchTracker::Instance = nullptr;
+
+void FMVVMHitchTracker::Startup()
+{
+	check(!Instance);
+	Instance = new FMVVMHitchTracker();
+	Instance->EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(Instance, &FMVVMHitchTracker::OnEndFrame);
+}
+
+void FMVVMHitchTracker::Shutdown()
+{
+	if(!Instance) return;
+
+	FCoreDelegates::OnEndFrame.Remove(Instance->EndFrameHandle);
+	delete Instance;
+	Instance = nullptr;
+}
+
+FMVVMHitchTracker* FMVVMHitchTracker::GetActive()
+{
+	return Instance && Instance->ThresholdMs > 0.0 && IsInGameThread() ? Instance : nullptr;
+}
+
+FMVVMHitchTracker* FMVVMHitchTracker::Get()
+{
+	return Instance;
+}
+
+void FMVVMHitchTracker::BeginScope()
+{
+	ScopeChildCycles.Add(0);
+}
+
+void FMVVMHitchTracker::EndScope(EMVVMWorkType WorkType, const UStruct* Type, uint64 InclusiveCycles)
+{
+	//Scopes opened before tracking was enabled have no entry
+	if(ScopeChildCycles.IsEmpty()) return;
+
+	const uint64 ChildCycles = ScopeChildCycles.Pop();
+	const uint64 ExclusiveCycles = InclusiveCycles > ChildCycles ? InclusiveCycles - ChildCycles : 0;
+	if(!ScopeChildCycles.IsEmpty())
+	{
+		ScopeChildCycles.Last() += InclusiveCycles;
+	}
+
+	const FName TypeName = Type ? Type->GetFName() : NAME_None;
+	auto* Sample = FrameSamples.FindByPredicate([TypeName, WorkType](const FFrameSample& FrameSample)
+	{
+		return FrameSample.TypeName == TypeName && FrameSample.WorkType == WorkType;
+	});
+	if(!Sample)
+	{
+		Sample = &FrameSamples.AddDefaulted_GetRef();
+		Sample->TypeName = TypeName;
+		Sample->WorkType = WorkType;
+	}
+
+	Sample->Cycles += ExclusiveCycles;
+	++Sample->Count;
+}
+
+void FMVVMHitchTracker::OnEndFrame()
+{
+	ThresholdMs = GetDefault<UMVVMLibrarySettings>()->HitchThresholdMs;
+
+	if(FrameSamples.IsEmpty()) return;
+
+	uint64 FrameCycles = 0;
+	for (const auto& Sample : FrameSamples)
+	{
+		FrameCycles += Sample.Cycles;
+	}
+
+	const double FrameMs = FPlatformTime::ToMilliseconds64(FrameCycles);
+	const bool bIsHitch = ThresholdMs > 0.0 && FrameMs >= ThresholdMs;
+
+	for (const auto& Sample : FrameSamples)
+	{
+		const double SampleMs = FPlatformTime::ToMilliseconds64(Sample.Cycles);
+
+		auto& Histogram = Histograms.FindOrAdd(MakeTuple(Sample.TypeName, Sample.WorkType));
+		++Histogram.Samples;
+		Histogram.TotalMs += SampleMs;
+		Histogram.MaxMs = FMath::Max(Histogram.MaxMs, SampleMs);
+
+		int32 Bucket = 0;
+		while(Bucket < NumBuckets - 1 && SampleMs >= BucketBoundsMs[Bucket])
+		{
+			++Bucket;
+		}
+		++Histogram.Buckets[Bucket];
+
+		if(bIsHitch)
+		{
+			++Histogram.HitchFrames;
+			Histogram.HitchMs += SampleMs;
+		}
+	}
+
+	if(bIsHitch)
+	{
+		FrameSamples.Sort([](const FFrameSample& A, const FFrameSample& B)
+		{
+			return A.Cycles > B.Cycles;
+		});
+
+		TStringBuilder<512> Breakdown;
+		const int32 NumLogged = FMath::Min(FrameSamples.Num(), MVVMHitchTracking::MaxLoggedSamples);
+		for (int32 Index = 0; Index < NumLogged; ++Index)
+		{
+			const auto& Sample = FrameSamples[Index];
+			Breakdown.Appendf(TEXT("%s%s %s %.2fms x%d"), Index > 0 ? TEXT(", ") : TEXT(""), *Sample.TypeName.ToString(),
+				LexToString(Sample.WorkType), FPlatformTime::ToMilliseconds64(Sample.Cycles), Sample.Count);
+		}
+		if(FrameSamples.Num() > NumLogged)
+		{
+			Breakdown.Appendf(TEXT(", +%d more"), FrameSamples.Num() - NumLogged);
+		}
+
+		UE_LOG(LogMVVMHitch, Warning, TEXT("MVVM took %.2fms in frame %llu: %s"), FrameMs, GFrameCounter, *Breakdown);
+	}
+
+	FrameSamples.Reset();
+}
+
+bool FMVVMHitchTracker::DumpCsv(const FString& FilePath) const
+{
+	const FString FullPath = FilePath.IsEmpty()
+		? FPaths::ProfilingDir() / TEXT("MVVM") / FString::Printf(TEXT("Hitches-%s.csv"), *FDateTime::Now().ToString())
+		: FPaths::ConvertRelativePathToFull(FilePath);
+
+	FString Csv = TEXT("Class,Work,Samples,HitchFrames,TotalMs,MaxMs,HitchMs");
+	for (int32 Bucket = 0; Bucket < NumBuckets - 1; ++Bucket)
+	{
+		Csv.Appendf(TEXT(",<%gms"), BucketBoundsMs[Bucket]);
+	}
+	Csv.Appendf(TEXT(",>=%gms\n"), BucketBoundsMs[NumBuckets - 2]);
+
+	for (const auto& [Key, Histogram] : Histograms)
+	{
+		Csv.Appendf(TEXT("%s,%s,%d,%d,%.3f,%.3f,%.3f"), *Key.Key.ToString(), LexToString(Key.Value),
+			Histogram.Samples, Histogram.HitchFrames, Histogram.TotalMs, Histogram.MaxMs, Histogram.HitchMs);
+		for (const int32 Count : Histogram.Buckets)
+		{
+			Csv.Appendf(TEXT(",%d"), Count);
+		}
+		Csv.AppendChar(TEXT('\n'));
+	}
+
+	if(!FFileHelper::SaveStringToFile(Csv, *FullPath))
+	{
+		UE_LOG(LogMVVMHitch, Error, TEXT("Can not write MVVM hitch histograms to %s"), *FullPath);
+		return false;
+	}
+
+	UE_LOG(LogMVVMHitch, Log, TEXT("MVVM hitch histograms written to %s"), *FullPath);
+	return true;
+}
+
+void FMVVMHitchTracker::ResetHistograms()
+{
+	Histograms.Reset();
+}
+
+#endif
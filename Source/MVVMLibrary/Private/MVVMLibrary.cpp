@@ -1,18 +1,25 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MVVMLibrary.h"
+#include "MVVMHitchTracker.h"
 
 #define LOCTEXT_NAMESPACE "FMVVMLibraryModule"
 
 void FMVVMLibraryModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+#if WITH_MVVM_HITCH_TRACKER
+	FMVVMHitchTracker::Startup();
+#endif
 }
 
 void FMVVMLibraryModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+#if WITH_MVVM_HITCH_TRACKER
+	FMVVMHitchTracker::Shutdown();
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
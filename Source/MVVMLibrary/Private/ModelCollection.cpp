@@ -0,0 +1,237 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "ModelCollection.h"
+
+void FOrderStatisticTree::Insert(int32 Element, FLess Less)
+{
+	check(Element >= 0 && !Contains(Element));
+
+	if(Element >= Nodes.Num())
+	{
+		Nodes.SetNum(Element + 1);
+	}
+
+	//Xorshift, random priorities keep the expected depth logarithmic
+	PrioritySeed ^= PrioritySeed << 13;
+	PrioritySeed ^= PrioritySeed >> 17;
+	PrioritySeed ^= PrioritySeed << 5;
+
+	auto& Node = Nodes[Element];
+	Node = FNode();
+	Node.Size = 1;
+	Node.Priority = PrioritySeed;
+	Node.bIsLinked = true;
+
+	int32 Left, Right;
+	SplitBy(Root, [Element, &Less](int32 Other)
+	{
+		return Less(Other, Element);
+	}, Left, Right);
+
+	Root = Merge(Merge(Left, Element), Right);
+	Nodes[Root].Parent = INDEX_NONE;
+}
+
+void FOrderStatisticTree::Remove(int32 Element)
+{
+	const int32 Position = IndexOf(Element);
+	if(Position == INDEX_NONE) return;
+
+	int32 Left, Middle, Right;
+	SplitAt(Root, Position, Left, Right);
+	SplitAt(Right, 1, Middle, Right);
+	check(Middle == Element);
+
+	Root = Merge(Left, Right);
+	if(Root != INDEX_NONE)
+	{
+		Nodes[Root].Parent = INDEX_NONE;
+	}
+
+	Nodes[Element] = FNode();
+}
+
+bool FOrderStatisticTree::Contains(int32 Element) const
+{
+	return Nodes.IsValidIndex(Element) && Nodes[Element].bIsLinked;
+}
+
+int32 FOrderStatisticTree::IndexOf(int32 Element) const
+{
+	if(!Contains(Element)) return INDEX_NONE;
+
+	int32 Position = SizeOf(Nodes[Element].Left);
+	for (int32 Node = Element; Nodes[Node].Parent != INDEX_NONE; Node = Nodes[Node].Parent)
+	{
+		const auto& Parent = Nodes[Nodes[Node].Parent];
+		if(Parent.Right == Node)
+		{
+			Position += SizeOf(Parent.Left) + 1;
+		}
+	}
+
+	return Position;
+}
+
+int32 FOrderStatisticTree::GetAt(int32 Position) const
+{
+	if(Position < 0 || Position >= Num()) return INDEX_NONE;
+
+	int32 Node = Root;
+	while(Node != INDEX_NONE)
+	{
+		const int32 LeftSize = SizeOf(Nodes[Node].Left);
+		if(Position < LeftSize)
+		{
+			Node = Nodes[Node].Left;
+		}
+		else if(Position == LeftSize)
+		{
+			return Node;
+		}
+		else
+		{
+			Position -= LeftSize + 1;
+			Node = Nodes[Node].Right;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void FOrderStatisticTree::ForEachInRange(int32 Start, int32 Count, TFunctionRef<void(int32 Element)> Callback) const
+{
+	int32 Node = GetAt(FMath::Max(Start, 0));
+	for (int32 Visited = 0; Visited < Count && Node != INDEX_NONE; ++Visited)
+	{
+		Callback(Node);
+		Node = Next(Node);
+	}
+}
+
+int32 FOrderStatisticTree::Num() const
+{
+	return SizeOf(Root);
+}
+
+void FOrderStatisticTree::Reset()
+{
+	Nodes.Reset();
+	Root = INDEX_NONE;
+}
+
+int32 FOrderStatisticTree::SizeOf(int32 Node) const
+{
+	return Node != INDEX_NONE ? Nodes[Node].Size : 0;
+}
+
+void FOrderStatisticTree::Update(int32 Node)
+{
+	auto& Current = Nodes[Node];
+	Current.Size = 1 + SizeOf(Current.Left) + SizeOf(Current.Right);
+	if(Current.Left != INDEX_NONE)
+	{
+		Nodes[Current.Left].Parent = Node;
+	}
+	if(Current.Right != INDEX_NONE)
+	{
+		Nodes[Current.Right].Parent = Node;
+	}
+}
+
+void FOrderStatisticTree::SplitBy(int32 Node, TFunctionRef<bool(int32)> GoesLeft, int32& OutLeft, int32& OutRight)
+{
+	if(Node == INDEX_NONE)
+	{
+		OutLeft = INDEX_NONE;
+		OutRight = INDEX_NONE;
+		return;
+	}
+
+	if(GoesLeft(Node))
+	{
+		int32 SplitLeft;
+		SplitBy(Nodes[Node].Right, GoesLeft, SplitLeft, OutRight);
+		Nodes[Node].Right = SplitLeft;
+		Update(Node);
+		OutLeft = Node;
+	}
+	else
+	{
+		int32 SplitRight;
+		SplitBy(Nodes[Node].Left, GoesLeft, OutLeft, SplitRight);
+		Nodes[Node].Left = SplitRight;
+		Update(Node);
+		OutRight = Node;
+	}
+}
+
+void FOrderStatisticTree::SplitAt(int32 Node, int32 Count, int32& OutLeft, int32& OutRight)
+{
+	if(Node == INDEX_NONE)
+	{
+		OutLeft = INDEX_NONE;
+		OutRight = INDEX_NONE;
+		return;
+	}
+
+	const int32 LeftSize = SizeOf(Nodes[Node].Left);
+	if(LeftSize < Count)
+	{
+		int32 SplitLeft;
+		SplitAt(Nodes[Node].Right, Count - LeftSize - 1, SplitLeft, OutRight);
+		Nodes[Node].Right = SplitLeft;
+		Update(Node);
+		OutLeft = Node;
+	}
+	else
+	{
+		int32 SplitRight;
+		SplitAt(Nodes[Node].Left, Count, OutLeft, SplitRight);
+		Nodes[Node].Left = SplitRight;
+		Update(Node);
+		OutRight = Node;
+	}
+}
+
+int32 FOrderStatisticTree::Merge(int32 Left, int32 Right)
+{
+	if(Left == INDEX_NONE) return Right;
+	if(Right == INDEX_NONE) return Left;
+
+	if(Nodes[Left].Priority > Nodes[Right].Priority)
+	{
+		const int32 Merged = Merge(Nodes[Left].Right, Right);
+		Nodes[Left].Right = Merged;
+		Update(Left);
+		return Left;
+	}
+
+	const int32 Merged = Merge(Left, Nodes[Right].Left);
+	Nodes[Right].Left = Merged;
+	Update(Right);
+	return Right;
+}
+
+int32 FOrderStatisticTree::Next(int32 Node) const
+{
+	if(Nodes[Node].Right != INDEX_NONE)
+	{
+		Node = Nodes[Node].Right;
+		while(Nodes[Node].Left != INDEX_NONE)
+		{
+			Node = Nodes[Node].Left;
+		}
+		return Node;
+	}
+
+	while(Nodes[Node].Parent != INDEX_NONE && Nodes[Nodes[Node].Parent].Right == Node)
+	{
+		Node = Nodes[Node].Parent;
+	}
+	return Nodes[Node].Parent;
+}
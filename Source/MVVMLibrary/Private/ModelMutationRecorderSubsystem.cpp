@@ -0,0 +1,476 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "ModelMutationRecorderSubsystem.h"
+
+#include "ModelRepositorySubsystem.h"
+#include "WorldModelRepositorySubsystem.h"
+#include "Abstract/UIContextualModel.h"
+#include "Abstract/UISessionModel.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructuredArchive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogModelMutationRecorder, Log, All);
+
+namespace ModelMutationRecording
+{
+	constexpr uint32 FileMagic = 0x524D564D;
+	/** 2: mutations carry the recorded frame and the entity key. 3: actor entities are recorded by their path in the world */
+	constexpr uint32 FileVersion = 3;
+
+	/** Actor id of mutations of models that do not belong to an actor */
+	constexpr uint16 NoActorId = MAX_uint16;
+
+	/** Every entry of the stream starts with one of these tags */
+	enum class EEntryType : uint8
+	{
+		DeclareClass,
+		DeclareField,
+		Mutation,
+		DeclareActor,
+	};
+
+	UModelMutationRecorderSubsystem* FindRecorder(const UWorld* World)
+	{
+		const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		return GameInstance ? GameInstance->GetSubsystem<UModelMutationRecorderSubsystem>() : nullptr;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs StartRecordingCommand(
+		TEXT("MVVM.Record.Start"),
+		TEXT("Starts recording model field changes. Usage: MVVM.Record.Start <File>"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if(const auto Recorder = FindRecorder(World))
+			{
+				Recorder->StartRecording(Args.IsValidIndex(0) ? Args[0] : TEXT("ModelMutations.mvvmrec"));
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs StopRecordingCommand(
+		TEXT("MVVM.Record.Stop"),
+		TEXT("Stops recording model field changes."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if(const auto Recorder = FindRecorder(World))
+			{
+				Recorder->StopRecording();
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs ReplayCommand(
+		TEXT("MVVM.Replay"),
+		TEXT("Replays recorded model field changes. Usage: MVVM.Replay <File> [PlaybackRate] [Frames|Time]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if(const auto Recorder = FindRecorder(World))
+			{
+				const float PlaybackRate = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 1.f;
+				const auto Mode = Args.IsValidIndex(2) && Args[2].Equals(TEXT("Time"), ESearchCase::IgnoreCase)
+					? EModelReplayMode::RecordedTime
+					: EModelReplayMode::RecordedFrames;
+				Recorder->StartReplay(Args.IsValidIndex(0) ? Args[0] : TEXT("ModelMutations.mvvmrec"), PlaybackRate, Mode);
+			}
+		}));
+}
+
+int32 UModelMutationRecorderSubsystem::ActiveRecordings = 0;
+
+void UModelMutationRecorderSubsystem::Deinitialize()
+{
+	StopReplay();
+	StopRecording();
+	
+	Super::Deinitialize();
+}
+
+bool UModelMutationRecorderSubsystem::StartRecording(const FString& FilePath)
+{
+	if(IsRecording()) return false;
+
+	const FString FullPath = ResolveRecordingPath(FilePath);
+	RecordWriter.Reset(IFileManager::Get().CreateFileWriter(*FullPath));
+	if(!RecordWriter)
+	{
+		UE_LOG(LogModelMutationRecorder, Warning, TEXT("Can not open %s for recording"), *FullPath);
+		return false;
+	}
+
+	uint32 Magic = ModelMutationRecording::FileMagic;
+	uint32 Version = ModelMutationRecording::FileVersion;
+	*RecordWriter << Magic << Version;
+
+	RecordStartTime = FPlatformTime::Seconds();
+	RecordStartFrame = GFrameCounter;
+	RecordedClassIds.Reset();
+	RecordedFieldIds.Reset();
+	RecordedActorIds.Reset();
+	++ActiveRecordings;
+
+	UE_LOG(LogModelMutationRecorder, Log, TEXT("Recording model mutations to %s"), *FullPath);
+	return true;
+}
+
+void UModelMutationRecorderSubsystem::StopRecording()
+{
+	if(!IsRecording()) return;
+
+	RecordWriter->Close();
+	RecordWriter.Reset();
+	--ActiveRecordings;
+}
+
+bool UModelMutationRecorderSubsystem::IsRecording() const
+{
+	return RecordWriter.IsValid();
+}
+
+bool UModelMutationRecorderSubsystem::StartReplay(const FString& FilePath, float PlaybackRate, EModelReplayMode Mode)
+{
+	if(IsReplaying() || PlaybackRate <= 0.f) return false;
+
+	if(!LoadRecording(ResolveRecordingPath(FilePath)))
+	{
+		return false;
+	}
+
+	NextReplayMutation = 0;
+	ReplayTime = 0.f;
+	ReplayFrame = 0.0;
+	ReplayRate = PlaybackRate;
+	ReplayMode = Mode;
+	SkippedReplayMutations = 0;
+	SkippedActorMutations = 0;
+	ReplayApplySeconds = 0.0;
+	ReplayApplySecondsPerClass.Reset();
+	ReplayWallStartTime = FPlatformTime::Seconds();
+	bIsReplaying = true;
+
+	return true;
+}
+
+void UModelMutationRecorderSubsystem::StopReplay()
+{
+	bIsReplaying = false;
+	ReplayMutations.Empty();
+	ReplayActorPaths.Empty();
+}
+
+bool UModelMutationRecorderSubsystem::IsReplaying() const
+{
+	return bIsReplaying;
+}
+
+void UModelMutationRecorderSubsystem::RecordFieldChange(const UObjectWithWorldContext* Model, FName FieldName)
+{
+	if(ActiveRecordings == 0 || !Model) return;
+
+	const auto Recorder = ModelMutationRecording::FindRecorder(Model->GetWorld());
+	//Changes applied by the replay itself are not recorded again
+	if(!Recorder || !Recorder->IsRecording() || Recorder->IsReplaying()) return;
+
+	const auto ModelKind = Model->IsA<UUIContextualModel>() ? ERecordedModelKind::Contextual : ERecordedModelKind::Session;
+	Recorder->WriteFieldChange(Model, ModelKind, FieldName);
+}
+
+void UModelMutationRecorderSubsystem::Tick(float DeltaTime)
+{
+	if(ReplayMode == EModelReplayMode::RecordedFrames)
+	{
+		//The first replay frame applies recorded frame 0. Every later one advances by the same step, whatever its duration
+		const uint64 LastFrame = static_cast<uint64>(ReplayFrame);
+		ReplayFrame += ReplayRate;
+
+		while(NextReplayMutation < ReplayMutations.Num() && ReplayMutations[NextReplayMutation].Frame <= LastFrame)
+		{
+			SkippedReplayMutations += ApplyMutation(ReplayMutations[NextReplayMutation++]) ? 0 : 1;
+		}
+	}
+	else
+	{
+		ReplayTime += DeltaTime * ReplayRate;
+
+		while(NextReplayMutation < ReplayMutations.Num() && ReplayMutations[NextReplayMutation].Time <= ReplayTime)
+		{
+			SkippedReplayMutations += ApplyMutation(ReplayMutations[NextReplayMutation++]) ? 0 : 1;
+		}
+	}
+
+	if(NextReplayMutation >= ReplayMutations.Num())
+	{
+		LogReplayReport();
+		StopReplay();
+	}
+}
+
+ETickableTickType UModelMutationRecorderSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UModelMutationRecorderSubsystem::IsTickable() const
+{
+	return bIsReplaying;
+}
+
+UWorld* UModelMutationRecorderSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetGameInstance()->GetWorld();
+}
+
+TStatId UModelMutationRecorderSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UModelMutationRecorderSubsystem, STATGROUP_Tickables);
+}
+
+void UModelMutationRecorderSubsystem::WriteFieldChange(const UObjectWithWorldContext* Model, ERecordedModelKind ModelKind, FName FieldName)
+{
+	UClass* ModelClass = Model->GetClass();
+	const FProperty* Property = ModelClass->FindPropertyByName(FieldName);
+	if(!Property)
+	{
+		UE_LOG(LogModelMutationRecorder, Warning, TEXT("%s has no field %s. The change is not recorded"), *ModelClass->GetName(), *FieldName.ToString());
+		return;
+	}
+
+	FArchive& Writer = *RecordWriter;
+
+	//Class and field names are written once, further entries refer to them by id
+	uint16 ClassId = 0;
+	if(const auto FoundClassId = RecordedClassIds.Find(ModelClass))
+	{
+		ClassId = *FoundClassId;
+	}
+	else
+	{
+		auto EntryType = ModelMutationRecording::EEntryType::DeclareClass;
+		ClassId = static_cast<uint16>(RecordedClassIds.Num());
+		FString ClassPath = ModelClass->GetPathName();
+		Writer << EntryType << ClassId << ClassPath;
+		RecordedClassIds.Add(ModelClass, ClassId);
+	}
+
+	uint16 FieldId = 0;
+	if(const auto FoundFieldId = RecordedFieldIds.Find(FieldName))
+	{
+		FieldId = *FoundFieldId;
+	}
+	else
+	{
+		auto EntryType = ModelMutationRecording::EEntryType::DeclareField;
+		FieldId = static_cast<uint16>(RecordedFieldIds.Num());
+		FString FieldString = FieldName.ToString();
+		Writer << EntryType << FieldId << FieldString;
+		RecordedFieldIds.Add(FieldName, FieldId);
+	}
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	FObjectAndNameAsStringProxyArchive PayloadArchive(PayloadWriter, false);
+	const auto MutableModel = const_cast<UObjectWithWorldContext*>(Model);
+	Property->SerializeItem(FStructuredArchiveFromArchive(PayloadArchive).GetSlot(), Property->ContainerPtrToValuePtr<void>(MutableModel));
+
+	//Entity models of one class are told apart by their key on replay
+	uint64 EntityKey = 0;
+	uint16 ActorId = ModelMutationRecording::NoActorId;
+	if(const auto ContextualModel = Cast<UUIContextualModel>(Model))
+	{
+		EntityKey = ContextualModel->EntityKey;
+
+		//Actor keys only live as long as the process, the actor is found again by its path in the world
+		if(const AActor* Actor = ContextualModel->EntityActor.Get())
+		{
+			if(const auto FoundActorId = RecordedActorIds.Find(EntityKey))
+			{
+				ActorId = *FoundActorId;
+			}
+			else if(RecordedActorIds.Num() < ModelMutationRecording::NoActorId)
+			{
+				auto DeclareType = ModelMutationRecording::EEntryType::DeclareActor;
+				ActorId = static_cast<uint16>(RecordedActorIds.Num());
+				FString ActorPath = Actor->GetPathName(Actor->GetWorld());
+				Writer << DeclareType << ActorId << ActorPath;
+				RecordedActorIds.Add(EntityKey, ActorId);
+			}
+		}
+	}
+
+	auto EntryType = ModelMutationRecording::EEntryType::Mutation;
+	float Time = static_cast<float>(FPlatformTime::Seconds() - RecordStartTime);
+	uint32 Frame = static_cast<uint32>(GFrameCounter - RecordStartFrame);
+	Writer << EntryType << Time << Frame << ModelKind << ClassId << EntityKey << ActorId << FieldId << Payload;
+}
+
+bool UModelMutationRecorderSubsystem::LoadRecording(const FString& FilePath)
+{
+	TArray<uint8> FileData;
+	if(!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		UE_LOG(LogModelMutationRecorder, Warning, TEXT("Can not read recording %s"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if(Magic != ModelMutationRecording::FileMagic || Version != ModelMutationRecording::FileVersion)
+	{
+		UE_LOG(LogModelMutationRecorder, Warning, TEXT("%s is not a supported model mutation recording (version %u, expected %u)"),
+			*FilePath, Version, ModelMutationRecording::FileVersion);
+		return false;
+	}
+
+	TArray<UClass*> Classes;
+	TArray<FName> Fields;
+	ReplayMutations.Reset();
+	ReplayActorPaths.Reset();
+
+	while(!Reader.AtEnd() && !Reader.IsError())
+	{
+		ModelMutationRecording::EEntryType EntryType;
+		Reader << EntryType;
+
+		switch (EntryType)
+		{
+		case ModelMutationRecording::EEntryType::DeclareClass:
+			{
+				uint16 ClassId = 0;
+				FString ClassPath;
+				Reader << ClassId << ClassPath;
+				Classes.SetNumZeroed(FMath::Max<int32>(Classes.Num(), ClassId + 1));
+				Classes[ClassId] = FSoftClassPath(ClassPath).TryLoadClass<UObjectWithWorldContext>();
+				UE_CLOG(!Classes[ClassId], LogModelMutationRecorder, Warning, TEXT("Recorded model class %s is not found. Its changes are skipped"), *ClassPath);
+				break;
+			}
+		case ModelMutationRecording::EEntryType::DeclareField:
+			{
+				uint16 FieldId = 0;
+				FString FieldString;
+				Reader << FieldId << FieldString;
+				Fields.SetNum(FMath::Max<int32>(Fields.Num(), FieldId + 1));
+				Fields[FieldId] = FName(*FieldString);
+				break;
+			}
+		case ModelMutationRecording::EEntryType::DeclareActor:
+			{
+				uint16 ActorId = 0;
+				FString ActorPath;
+				Reader << ActorId << ActorPath;
+				ReplayActorPaths.SetNum(FMath::Max<int32>(ReplayActorPaths.Num(), ActorId + 1));
+				ReplayActorPaths[ActorId] = MoveTemp(ActorPath);
+				break;
+			}
+		case ModelMutationRecording::EEntryType::Mutation:
+			{
+				FRecordedModelMutation Mutation;
+				uint16 ClassId = 0;
+				uint16 ActorId = 0;
+				uint16 FieldId = 0;
+				Reader << Mutation.Time << Mutation.Frame << Mutation.ModelKind << ClassId << Mutation.EntityKey << ActorId << FieldId << Mutation.Payload;
+				if(Classes.IsValidIndex(ClassId) && Classes[ClassId] && Fields.IsValidIndex(FieldId))
+				{
+					Mutation.ModelClass = Classes[ClassId];
+					Mutation.FieldName = Fields[FieldId];
+					Mutation.ActorIndex = ReplayActorPaths.IsValidIndex(ActorId) ? ActorId : INDEX_NONE;
+					ReplayMutations.Add(MoveTemp(Mutation));
+				}
+				break;
+			}
+		default:
+			UE_LOG(LogModelMutationRecorder, Warning, TEXT("%s is corrupted"), *FilePath);
+			return false;
+		}
+	}
+
+	return !Reader.IsError() && !ReplayMutations.IsEmpty();
+}
+
+bool UModelMutationRecorderSubsystem::ApplyMutation(const FRecordedModelMutation& Mutation)
+{
+	UClass* ModelClass = Mutation.ModelClass;
+	const FProperty* Property = ModelClass ? ModelClass->FindPropertyByName(Mutation.FieldName) : nullptr;
+	if(!Property) return false;
+
+	//Only models that exist are replayed into: creating them here would add their construction to the measurement
+	UUISessionModel* SessionModel = nullptr;
+	UUIContextualModel* ContextualModel = nullptr;
+	if(Mutation.ModelKind == ERecordedModelKind::Session)
+	{
+		if(const auto ModelRepository = GetGameInstance()->GetSubsystem<UModelRepositorySubsystem>())
+		{
+			SessionModel = ModelRepository->FindSessionModel(ModelClass);
+		}
+	}
+	else if(const auto World = GetGameInstance()->GetWorld())
+	{
+		if(const auto WorldModelRepository = World->GetSubsystem<UWorldModelRepositorySubsystem>())
+		{
+			if(Mutation.ActorIndex != INDEX_NONE)
+			{
+				//The recorded key belongs to the recording process, the key of the same actor in this one is used
+				const auto Actor = FindObject<AActor>(World, *ReplayActorPaths[Mutation.ActorIndex]);
+				ContextualModel = Actor ? WorldModelRepository->FindEntityModel(ModelClass, UWorldModelRepositorySubsystem::MakeEntityKey(Actor)) : nullptr;
+				SkippedActorMutations += Actor ? 0 : 1;
+			}
+			else
+			{
+				ContextualModel = Mutation.EntityKey != 0
+					? WorldModelRepository->FindEntityModel(ModelClass, Mutation.EntityKey)
+					: WorldModelRepository->FindContextualModel(ModelClass);
+			}
+		}
+	}
+
+	UObject* Model = SessionModel ? static_cast<UObject*>(SessionModel) : ContextualModel;
+	if(!Model) return false;
+
+	FMemoryReader PayloadReader(Mutation.Payload);
+	FObjectAndNameAsStringProxyArchive PayloadArchive(PayloadReader, true);
+	Property->SerializeItem(FStructuredArchiveFromArchive(PayloadArchive).GetSlot(), Property->ContainerPtrToValuePtr<void>(Model));
+
+	//Only the notification is measured: it is where viewmodels and views react to the change
+	const double StartTime = FPlatformTime::Seconds();
+	if(SessionModel)
+	{
+		SessionModel->NotifyFieldChanged(Mutation.FieldName);
+	}
+	else
+	{
+		ContextualModel->NotifyFieldChanged(Mutation.FieldName);
+	}
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	ReplayApplySeconds += ElapsedSeconds;
+	ReplayApplySecondsPerClass.FindOrAdd(ModelClass) += ElapsedSeconds;
+	return true;
+}
+
+void UModelMutationRecorderSubsystem::LogReplayReport() const
+{
+	UE_LOG(LogModelMutationRecorder, Log, TEXT("Replayed %d model mutations by recorded %s at x%.2f in %.2f s, %d skipped without a target model (%d of them without the recorded actor). Update cost: %.3f ms total"),
+		ReplayMutations.Num() - SkippedReplayMutations, ReplayMode == EModelReplayMode::RecordedFrames ? TEXT("frames") : TEXT("time"),
+		ReplayRate, FPlatformTime::Seconds() - ReplayWallStartTime, SkippedReplayMutations, SkippedActorMutations, ReplayApplySeconds * 1000.0);
+
+	for (const auto& [ModelClass, Seconds] : ReplayApplySecondsPerClass)
+	{
+		UE_LOG(LogModelMutationRecorder, Log, TEXT("    %s: %.3f ms"), *GetNameSafe(ModelClass), Seconds * 1000.0);
+	}
+}
+
+FString UModelMutationRecorderSubsystem::ResolveRecordingPath(const FString& FilePath)
+{
+	return FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProfilingDir(), TEXT("MVVM"), FilePath) : FilePath;
+}
@@ -0,0 +1,200 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "ModelNumericChannels.h"
+
+int32 FModelNumericChannels::AddChannel(FName Name, float Tolerance)
+{
+	check(FindChannel(Name) == INDEX_NONE);
+
+	auto& Channel = Channels.AddDefaulted_GetRef();
+	Channel.Name = Name;
+	Channel.Tolerance = FMath::Max(Tolerance, 0.f);
+
+	const int32 NumPadded = NumPaddedEntities();
+	Channel.Values.SetNumZeroed(NumPadded);
+	Channel.ReportedValues.SetNumZeroed(NumPadded);
+	Channel.DirtyBits.SetNumZeroed(NumPadded / EntitiesPerWord);
+
+	return Channels.Num() - 1;
+}
+
+int32 FModelNumericChannels::FindChannel(FName Name) const
+{
+	return Channels.IndexOfByPredicate([Name](const FChannel& Channel)
+	{
+		return Channel.Name == Name;
+	});
+}
+
+int32 FModelNumericChannels::NumChannels() const
+{
+	return Channels.Num();
+}
+
+void FModelNumericChannels::SetNumEntities(int32 Num)
+{
+	check(Num >= 0);
+
+	const int32 OldCount = EntityCount;
+	EntityCount = Num;
+
+	const int32 NumPadded = NumPaddedEntities();
+	const int32 NumWords = NumPadded / EntitiesPerWord;
+	for (auto& Channel : Channels)
+	{
+		Channel.Values.SetNumZeroed(NumPadded);
+		Channel.ReportedValues.SetNumZeroed(NumPadded);
+		Channel.DirtyBits.SetNumZeroed(NumWords);
+
+		//Padding of a shrunk channel must compare equal
+		for (int32 Entity = Num; Entity < FMath::Min(OldCount, NumPadded); ++Entity)
+		{
+			Channel.Values[Entity] = 0.f;
+			Channel.ReportedValues[Entity] = 0.f;
+		}
+	}
+	AnyDirtyBits.SetNumZeroed(NumWords);
+	ForcedDirtyBits.SetNumZeroed(NumWords);
+
+	//Stale bits of removed entities in the last word
+	if(NumWords > 0 && Num % EntitiesPerWord != 0)
+	{
+		const uint32 ValidMask = (1u << (Num % EntitiesPerWord)) - 1;
+		ForcedDirtyBits.Last() &= ValidMask;
+		AnyDirtyBits.Last() &= ValidMask;
+		for (auto& Channel : Channels)
+		{
+			Channel.DirtyBits.Last() &= ValidMask;
+		}
+	}
+
+	for (int32 Entity = OldCount; Entity < Num; ++Entity)
+	{
+		MarkEntityDirty(Entity);
+	}
+}
+
+int32 FModelNumericChannels::NumEntities() const
+{
+	return EntityCount;
+}
+
+void FModelNumericChannels::SetValue(int32 Channel, int32 Entity, float Value)
+{
+	check(Entity >= 0 && Entity < EntityCount);
+	Channels[Channel].Values[Entity] = Value;
+}
+
+float FModelNumericChannels::GetValue(int32 Channel, int32 Entity) const
+{
+	check(Entity >= 0 && Entity < EntityCount);
+	return Channels[Channel].Values[Entity];
+}
+
+TArrayView<float> FModelNumericChannels::GetValues(int32 Channel)
+{
+	return TArrayView<float>(Channels[Channel].Values.GetData(), EntityCount);
+}
+
+TConstArrayView<float> FModelNumericChannels::GetValues(int32 Channel) const
+{
+	return TConstArrayView<float>(Channels[Channel].Values.GetData(), EntityCount);
+}
+
+void FModelNumericChannels::MarkEntityDirty(int32 Entity)
+{
+	check(Entity >= 0 && Entity < EntityCount);
+	ForcedDirtyBits[Entity / EntitiesPerWord] |= 1u << (Entity % EntitiesPerWord);
+}
+
+int32 FModelNumericChannels::DetectChanges()
+{
+	const int32 NumWords = AnyDirtyBits.Num();
+	FMemory::Memcpy(AnyDirtyBits.GetData(), ForcedDirtyBits.GetData(), NumWords * sizeof(uint32));
+
+	for (auto& Channel : Channels)
+	{
+		const float* Values = Channel.Values.GetData();
+		float* ReportedValues = Channel.ReportedValues.GetData();
+		const VectorRegister4Float Tolerance = VectorSetFloat1(Channel.Tolerance);
+
+		for (int32 Word = 0; Word < NumWords; ++Word)
+		{
+			uint32 Bits = 0;
+			for (int32 Group = 0; Group < EntitiesPerWord / 4; ++Group)
+			{
+				const int32 First = Word * EntitiesPerWord + Group * 4;
+				const VectorRegister4Float Value = VectorLoadAligned(Values + First);
+				const VectorRegister4Float Reported = VectorLoadAligned(ReportedValues + First);
+				//NaN compares false against the tolerance, so entering or leaving NaN is detected separately.
+				//Lanes that stay NaN or stay at the same infinity are unchanged
+				const VectorRegister4Float NaNChanged = VectorBitwiseXor(VectorCompareNE(Value, Value), VectorCompareNE(Reported, Reported));
+				const VectorRegister4Float Changed = VectorBitwiseOr(VectorCompareGT(VectorAbs(VectorSubtract(Value, Reported)), Tolerance), NaNChanged);
+
+				Bits |= static_cast<uint32>(VectorMaskBits(Changed)) << (Group * 4);
+				//Only reported lanes are committed, so changes below the tolerance accumulate
+				VectorStoreAligned(VectorSelect(Changed, Value, Reported), ReportedValues + First);
+			}
+
+			Bits |= ForcedDirtyBits[Word];
+			Channel.DirtyBits[Word] = Bits;
+			AnyDirtyBits[Word] |= Bits;
+		}
+	}
+
+	FMemory::Memzero(ForcedDirtyBits.GetData(), NumWords * sizeof(uint32));
+
+	int32 NumDirty = 0;
+	for (const uint32 Bits : AnyDirtyBits)
+	{
+		NumDirty += FMath::CountBits(Bits);
+	}
+
+	if(NumDirty > 0)
+	{
+		++ChangeSerial;
+	}
+
+	return NumDirty;
+}
+
+bool FModelNumericChannels::IsDirty(int32 Channel, int32 Entity) const
+{
+	const auto Bits = GetDirtyBits(Channel);
+	const int32 Word = Entity / EntitiesPerWord;
+	return Bits.IsValidIndex(Word) && (Bits[Word] & (1u << (Entity % EntitiesPerWord))) != 0;
+}
+
+void FModelNumericChannels::ForEachDirtyEntity(int32 Channel, TFunctionRef<void(int32 Entity)> Callback) const
+{
+	const auto Bits = GetDirtyBits(Channel);
+	for (int32 Word = 0; Word < Bits.Num(); ++Word)
+	{
+		uint32 WordBits = Bits[Word];
+		while(WordBits != 0)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros(WordBits));
+			Callback(Word * EntitiesPerWord + Bit);
+			WordBits &= WordBits - 1;
+		}
+	}
+}
+
+TConstArrayView<uint32> FModelNumericChannels::GetDirtyBits(int32 Channel) const
+{
+	return Channel == INDEX_NONE ? TConstArrayView<uint32>(AnyDirtyBits) : TConstArrayView<uint32>(Channels[Channel].DirtyBits);
+}
+
+uint32 FModelNumericChannels::GetChangeSerial() const
+{
+	return ChangeSerial;
+}
+
+int32 FModelNumericChannels::NumPaddedEntities() const
+{
+	return Align(EntityCount, EntitiesPerWord);
+}
@@ -7,6 +7,25 @@
 #include "ModelRepositorySubsystem.h"
 
 #include "Abstract/UISessionModel.h"
+#include "MVVMHitchTracker.h"
+#include "Misc/CoreDelegates.h"
+
+void UModelRepositorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LightModels.SetContext(this, nullptr);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UModelRepositorySubsystem::PublishDirtySnapshots);
+}
+
+void UModelRepositorySubsystem::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	DirtySnapshotModels.Empty();
+	PublishingSnapshotModels.Empty();
+
+	Super::Deinitialize();
+}
 
 void UModelRepositorySubsystem::K2_GetSessionModel(UUISessionModel*& OutSessionModel,
 	TSubclassOf<UUISessionModel> ModelType)
@@ -18,31 +37,76 @@ UUISessionModel* UModelRepositorySubsystem::GetSessionModel(TSubclassOf<UUISessi
 {
 	if(!IsValid(ModelType)) return nullptr;
 	
-	if(SessionModels.Contains(ModelType))
+	if(const auto SessionModel = SessionModels.Find(ModelType))
 	{
-		return SessionModels[ModelType];
+		return *SessionModel;
 	}
 
 	return CreateSessionModel(ModelType);
 }
 
+UUISessionModel* UModelRepositorySubsystem::FindSessionModel(TSubclassOf<UUISessionModel> ModelType) const
+{
+	const auto SessionModel = SessionModels.Find(ModelType);
+	return SessionModel ? *SessionModel : nullptr;
+}
+
 void UModelRepositorySubsystem::CloseSession()
 {
 	for (const auto& [ModelType, SessionModel] : SessionModels)
 	{
 		if(SessionModel)
+		{
+			MVVM_HITCH_SCOPE(Teardown, SessionModel->GetClass());
 			SessionModel->EndSession();
+		}
 	}
 
 	SessionModels.Empty();
+	LightModels.Empty();
+	DirtySnapshotModels.Empty();
 }
 
 UUISessionModel* UModelRepositorySubsystem::CreateSessionModel(const TSubclassOf<UUISessionModel>& ModelType)
 {
-	UUISessionModel* NewModel = NewObject<UUISessionModel>(this, ModelType);
+	UUISessionModel* NewModel = nullptr;
+	{
+		MVVM_HITCH_SCOPE(ModelCreation, ModelType);
+		NewModel = NewObject<UUISessionModel>(this, ModelType);
+	}
 	SessionModels.Add(ModelType, NewModel);
 	NewModel->SetModelRepository(this);
+
+	MVVM_HITCH_SCOPE(ModelInitialization, ModelType);
 	NewModel->StartSession();
+	//Worker threads see the initial state without waiting for the first change
+	NewModel->PublishSnapshot();
 
 	return NewModel;
 }
+
+void UModelRepositorySubsystem::MarkSnapshotDirty(UUISessionModel* Model)
+{
+	DirtySnapshotModels.Add(Model);
+}
+
+void UModelRepositorySubsystem::PublishDirtySnapshots()
+{
+	if(DirtySnapshotModels.IsEmpty()) return;
+
+	//Models changed while publishing are queued again and published in the next frame.
+	//Swapped with the scratch array, so both keep their allocations across frames
+	Swap(DirtySnapshotModels, PublishingSnapshotModels);
+
+	for (const auto& Model : PublishingSnapshotModels)
+	{
+		if(Model.IsValid() && Model->bIsSnapshotDirty)
+		{
+			//Cleared first: a change raised by PublishSnapshot marks the model dirty again
+			Model->bIsSnapshotDirty = false;
+			Model->PublishSnapshot();
+		}
+	}
+
+	PublishingSnapshotModels.Reset();
+}
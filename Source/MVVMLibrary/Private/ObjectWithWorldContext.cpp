@@ -34,3 +34,8 @@ UWorld* UObjectWithWorldContext::GetWorld() const
 
 	return nullptr;
 }
+
+void UObjectWithWorldContext::BindWorldContext(UWorld* InWorld)
+{
+	CachedWorld = InWorld;
+}
@@ -0,0 +1,29 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abstract/UISessionModel.h"
+#include "Abstract/UIContextualModel.h"
+#include "MVVMTestModels.generated.h"
+
+/**
+ * Concrete session model for automation tests.
+ */
+UCLASS(Transient, HideDropdown, NotBlueprintable)
+class UMVVMTestSessionModel : public UUISessionModel
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Concrete contextual model for automation tests.
+ */
+UCLASS(Transient, HideDropdown, NotBlueprintable)
+class UMVVMTestContextualModel : public UUIContextualModel
+{
+	GENERATED_BODY()
+};
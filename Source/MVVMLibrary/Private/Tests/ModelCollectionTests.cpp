@@ -0,0 +1,273 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ModelCollection.h"
+#include "Algo/BinarySearch.h"
+#include "Math/RandomStream.h"
+
+namespace ModelCollectionTests
+{
+	constexpr int32 NumOperations = 2000;
+	constexpr int32 NumKeys = 200;
+	constexpr int32 NumValues = 16;
+
+	struct FTestEntry
+	{
+		int32 Value = 0;
+	};
+
+	bool LessByValue(const FTestEntry& A, const FTestEntry& B)
+	{
+		return A.Value < B.Value;
+	}
+
+	bool IsEven(const FTestEntry& Entry)
+	{
+		return Entry.Value % 2 == 0;
+	}
+
+	/** Keys of the index the way a full sort would order them: by value, equal values by key */
+	TArray<int64> SortReference(const TMap<int64, int32>& Values, TFunctionRef<bool(int32 Value)> Filter)
+	{
+		TArray<int64> Keys;
+		for (const auto& Pair : Values)
+		{
+			if(Filter(Pair.Value))
+			{
+				Keys.Add(Pair.Key);
+			}
+		}
+
+		Keys.Sort([&Values](int64 A, int64 B)
+		{
+			const int32 ValueA = Values[A];
+			const int32 ValueB = Values[B];
+			return ValueA != ValueB ? ValueA < ValueB : A < B;
+		});
+		return Keys;
+	}
+
+	/** @return Does every position of the index hold the reference key, and does IndexOf agree with GetAt? */
+	bool MatchesReference(FAutomationTestBase& Test, const TModelCollection<FTestEntry>& Collection, FName IndexName, const TArray<int64>& Reference)
+	{
+		if(!Test.TestEqual(FString::Printf(TEXT("%s size"), *IndexName.ToString()), Collection.NumInIndex(IndexName), Reference.Num()))
+		{
+			return false;
+		}
+
+		for (int32 Position = 0; Position < Reference.Num(); ++Position)
+		{
+			int64 Key = INDEX_NONE;
+			const FTestEntry* Entry = Collection.GetAt(IndexName, Position, &Key);
+			if(!Entry || Key != Reference[Position] || Collection.IndexOf(IndexName, Key) != Position)
+			{
+				Test.AddError(FString::Printf(TEXT("%s differs from the reference at position %d"), *IndexName.ToString(), Position));
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOrderStatisticTreeTest, "MVVMLibrary.ModelCollection.OrderStatisticTree",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOrderStatisticTreeTest::RunTest(const FString& Parameters)
+{
+	using namespace ModelCollectionTests;
+
+	FRandomStream Random(0x4D56564D);
+	TArray<int32> Weights;
+	Weights.SetNum(NumKeys);
+	for (int32& Weight : Weights)
+	{
+		Weight = Random.RandRange(0, NumValues - 1);
+	}
+
+	const auto Less = [&Weights](int32 A, int32 B)
+	{
+		return Weights[A] != Weights[B] ? Weights[A] < Weights[B] : A < B;
+	};
+
+	FOrderStatisticTree Tree;
+	TArray<int32> Reference;
+	for (int32 Operation = 0; Operation < NumOperations; ++Operation)
+	{
+		const int32 Element = Random.RandRange(0, NumKeys - 1);
+		if(Tree.Contains(Element))
+		{
+			Tree.Remove(Element);
+			Reference.Remove(Element);
+		}
+		else
+		{
+			Tree.Insert(Element, Less);
+			Reference.Insert(Element, Algo::LowerBound(Reference, Element, Less));
+		}
+	}
+
+	if(!TestEqual(TEXT("Size"), Tree.Num(), Reference.Num())) return false;
+
+	for (int32 Position = 0; Position < Reference.Num(); ++Position)
+	{
+		if(Tree.GetAt(Position) != Reference[Position] || Tree.IndexOf(Reference[Position]) != Position)
+		{
+			AddError(FString::Printf(TEXT("Tree differs from the reference at position %d"), Position));
+			return false;
+		}
+	}
+
+	TArray<int32> Page;
+	Tree.ForEachInRange(Reference.Num() / 2, 10, [&Page](int32 Element)
+	{
+		Page.Add(Element);
+	});
+	const int32 PageStart = Reference.Num() / 2;
+	TestEqual(TEXT("Page size"), Page.Num(), FMath::Min(10, Reference.Num() - PageStart));
+	for (int32 Offset = 0; Offset < Page.Num(); ++Offset)
+	{
+		TestEqual(TEXT("Page element"), Page[Offset], Reference[PageStart + Offset]);
+	}
+
+	TestEqual(TEXT("GetAt out of range"), Tree.GetAt(Reference.Num()), static_cast<int32>(INDEX_NONE));
+	TestEqual(TEXT("IndexOf of a missing element"), Tree.IndexOf(NumKeys), static_cast<int32>(INDEX_NONE));
+
+	Tree.Reset();
+	TestEqual(TEXT("Size after Reset"), Tree.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModelCollectionIndicesTest, "MVVMLibrary.ModelCollection.Indices",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FModelCollectionIndicesTest::RunTest(const FString& Parameters)
+{
+	using namespace ModelCollectionTests;
+
+	const FName AllIndex(TEXT("All"));
+	const FName EvenIndex(TEXT("Even"));
+
+	TModelCollection<FTestEntry> Collection;
+	Collection.AddIndex(AllIndex, &LessByValue);
+	Collection.AddIndex(EvenIndex, &LessByValue, &IsEven);
+
+	//Replays every broadcast onto a plain array of keys per index, which must end up equal to the index itself
+	TMap<FName, TArray<int64>> Mirrors;
+	Mirrors.Add(AllIndex);
+	Mirrors.Add(EvenIndex);
+	bool bIsMirrorConsistent = true;
+	Collection.OnIndexChanged.AddLambda([&Mirrors, &bIsMirrorConsistent](FName IndexName, int64 Key, int32 OldPosition, int32 NewPosition)
+	{
+		TArray<int64>& Mirror = Mirrors[IndexName];
+		if(OldPosition != INDEX_NONE)
+		{
+			bIsMirrorConsistent &= Mirror.IsValidIndex(OldPosition) && Mirror[OldPosition] == Key;
+			Mirror.RemoveAt(OldPosition);
+		}
+		if(NewPosition != INDEX_NONE)
+		{
+			bIsMirrorConsistent &= NewPosition <= Mirror.Num();
+			Mirror.Insert(Key, FMath::Min(NewPosition, Mirror.Num()));
+		}
+	});
+
+	FRandomStream Random(0x434F4C4C);
+	TMap<int64, int32> Values;
+	for (int32 Operation = 0; Operation < NumOperations; ++Operation)
+	{
+		const int64 Key = Random.RandRange(0, NumKeys - 1);
+		const int32 Value = Random.RandRange(0, NumValues - 1);
+		switch (Random.RandRange(0, 2))
+		{
+		case 0:
+			Collection.Set(Key, FTestEntry{ Value });
+			Values.Add(Key, Value);
+			break;
+		case 1:
+			TestEqual(TEXT("Update finds the key"), Collection.Update(Key, [Value](FTestEntry& Entry)
+			{
+				Entry.Value = Value;
+			}), Values.Contains(Key));
+			if(int32* Existing = Values.Find(Key))
+			{
+				*Existing = Value;
+			}
+			break;
+		default:
+			TestEqual(TEXT("Remove finds the key"), Collection.Remove(Key), Values.Remove(Key) > 0);
+			break;
+		}
+	}
+
+	TestEqual(TEXT("Size"), Collection.Num(), Values.Num());
+	MatchesReference(*this, Collection, AllIndex, SortReference(Values, [](int32) { return true; }));
+	MatchesReference(*this, Collection, EvenIndex, SortReference(Values, [](int32 Value) { return Value % 2 == 0; }));
+	TestTrue(TEXT("Broadcast positions are consistent"), bIsMirrorConsistent);
+	TestTrue(TEXT("Broadcasts replay into the All index"), Mirrors[AllIndex] == SortReference(Values, [](int32) { return true; }));
+	TestTrue(TEXT("Broadcasts replay into the Even index"), Mirrors[EvenIndex] == SortReference(Values, [](int32 Value) { return Value % 2 == 0; }));
+
+	//Rebuilding one index leaves the other one untouched
+	Collection.SetIndexFilter(EvenIndex, [](const FTestEntry& Entry)
+	{
+		return Entry.Value % 2 != 0;
+	});
+	MatchesReference(*this, Collection, EvenIndex, SortReference(Values, [](int32 Value) { return Value % 2 != 0; }));
+	MatchesReference(*this, Collection, AllIndex, SortReference(Values, [](int32) { return true; }));
+
+	Collection.SetIndexFilter(EvenIndex, nullptr);
+	MatchesReference(*this, Collection, EvenIndex, SortReference(Values, [](int32) { return true; }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModelCollectionTieBreakTest, "MVVMLibrary.ModelCollection.KeyTieBreak",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FModelCollectionTieBreakTest::RunTest(const FString& Parameters)
+{
+	using namespace ModelCollectionTests;
+
+	const FName IndexName(TEXT("ByValue"));
+
+	TModelCollection<FTestEntry> Collection;
+	Collection.AddIndex(IndexName, &LessByValue);
+
+	//Inserted out of key order, all equal by value
+	for (const int64 Key : { 5, 1, 4, 2, 3 })
+	{
+		Collection.Set(Key, FTestEntry{ 7 });
+	}
+
+	for (int32 Position = 0; Position < 5; ++Position)
+	{
+		int64 Key = INDEX_NONE;
+		Collection.GetAt(IndexName, Position, &Key);
+		TestEqual(TEXT("Equal entries are ordered by key"), Key, static_cast<int64>(Position + 1));
+	}
+
+	//Moving away and back returns an entry to its key position, not to the end of the equal range
+	Collection.Update(3, [](FTestEntry& Entry) { Entry.Value = 8; });
+	TestEqual(TEXT("Moved entry"), Collection.IndexOf(IndexName, 3), 4);
+	Collection.Update(3, [](FTestEntry& Entry) { Entry.Value = 7; });
+	TestEqual(TEXT("Returned entry"), Collection.IndexOf(IndexName, 3), 2);
+
+	//A changed order rebuilds with the same tie-break
+	Collection.SetIndexOrder(IndexName, [](const FTestEntry& A, const FTestEntry& B)
+	{
+		return A.Value > B.Value;
+	});
+	TestEqual(TEXT("Tie-break after a new order"), Collection.IndexOf(IndexName, 1), 0);
+	TestEqual(TEXT("Tie-break after a new order"), Collection.IndexOf(IndexName, 5), 4);
+
+	return true;
+}
+
+#endif
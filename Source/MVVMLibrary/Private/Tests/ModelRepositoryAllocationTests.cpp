@@ -0,0 +1,61 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/MVVMTestModels.h"
+#include "Tests/MVVMTestUtilities.h"
+#include "ModelRepositorySubsystem.h"
+#include "WorldModelRepositorySubsystem.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModelRepositoryLookupAllocationTest, "MVVMLibrary.Allocations.ModelRepositoryLookups",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FModelRepositoryLookupAllocationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCalls = 1000;
+
+	FMVVMTestWorld TestWorld;
+	const auto ModelRepository = TestWorld.GetGameInstance()->GetSubsystem<UModelRepositorySubsystem>();
+	const auto WorldModelRepository = TestWorld.GetWorld()->GetSubsystem<UWorldModelRepositorySubsystem>();
+	if(!TestNotNull(TEXT("Model repository"), ModelRepository) || !TestNotNull(TEXT("World model repository"), WorldModelRepository))
+	{
+		return false;
+	}
+
+	//The first calls create the models
+	const auto SessionModel = ModelRepository->GetSessionModel(UMVVMTestSessionModel::StaticClass());
+	const auto ContextualModel = WorldModelRepository->GetContextualModel(UMVVMTestContextualModel::StaticClass());
+	TestNotNull(TEXT("Session model"), SessionModel);
+	TestNotNull(TEXT("Contextual model"), ContextualModel);
+
+	{
+		FMVVMScopedAllocationCounter Allocations;
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			ModelRepository->GetSessionModel(UMVVMTestSessionModel::StaticClass());
+		}
+		TestEqual(TEXT("Allocations of GetSessionModel hits"), Allocations.GetNumAllocations(), 0);
+	}
+
+	{
+		FMVVMScopedAllocationCounter Allocations;
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			WorldModelRepository->GetContextualModel(UMVVMTestContextualModel::StaticClass());
+		}
+		TestEqual(TEXT("Allocations of GetContextualModel hits"), Allocations.GetNumAllocations(), 0);
+	}
+
+	TestTrue(TEXT("GetSessionModel hit returns the same model"), ModelRepository->GetSessionModel(UMVVMTestSessionModel::StaticClass()) == SessionModel);
+	TestTrue(TEXT("GetContextualModel hit returns the same model"), WorldModelRepository->GetContextualModel(UMVVMTestContextualModel::StaticClass()) == ContextualModel);
+
+	return true;
+}
+
+#endif
@@ -8,6 +8,19 @@
 
 #include "Abstract/UIContextualModel.h"
 #include "ModelRepositorySubsystem.h"
+#include "MVVMLibrarySettings.h"
+#include "MVVMHitchTracker.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+bool FContextualModelUsage::HasLiveUsers() const
+{
+	return Users.ContainsByPredicate([](const TWeakObjectPtr<const UObject>& User)
+	{
+		return User.IsValid();
+	});
+}
 
 void UWorldModelRepositorySubsystem::K2_GetContextualModel(UUIContextualModel*& OutContextualModel,
 	TSubclassOf<UUIContextualModel> ModelType)
@@ -15,15 +28,61 @@ void UWorldModelRepositorySubsystem::K2_GetContextualModel(UUIContextualModel*&
 	OutContextualModel = GetContextualModel(MoveTemp(ModelType));
 }
 
+bool UWorldModelRepositorySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	//Contextual models belong to gameplay scenes only
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWorldModelRepositorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	//Bind the session repository once, so model creation never has to resolve it again
+	LightModels.SetContext(GetModeRepositorySubsystem(), this);
+}
+
+void UWorldModelRepositorySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	InWorld.GetTimerManager().SetTimer(EvictionTimerHandle, this, &ThisClass::EvictIdleModels,
+		GetDefault<UMVVMLibrarySettings>()->ContextualModelEvictionInterval, true);
+}
+
 void UWorldModelRepositorySubsystem::Deinitialize()
 {
+	if(const auto World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(EvictionTimerHandle);
+	}
+
 	for (const auto& [ModelType, ContextualModel] : ContextualModels)
 	{
 		if(ContextualModel)
+		{
+			MVVM_HITCH_SCOPE(Teardown, ContextualModel->GetClass());
 			ContextualModel->OnDestroyModel();
+		}
 	}
 
 	ContextualModels.Empty();
+	ModelUsages.Empty();
+
+	for (const auto& [ModelType, Bucket] : EntityModels)
+	{
+		for (const auto EntityModel : Bucket.Models)
+		{
+			if(EntityModel)
+			{
+				MVVM_HITCH_SCOPE(Teardown, EntityModel->GetClass());
+				EntityModel->OnDestroyModel();
+			}
+		}
+	}
+	EntityModels.Empty();
+	LightModels.Empty();
+	ModelRepositorySubsystemCache.Reset();
 	
 	Super::Deinitialize();
 }
@@ -32,29 +91,302 @@ UUIContextualModel* UWorldModelRepositorySubsystem::GetContextualModel(TSubclass
 {
 	if(!IsValid(ModelType)) return nullptr;
 	
-	if(ContextualModels.Contains(ModelType))
+	if(const auto ContextualModel = ContextualModels.Find(ModelType))
 	{
-		return ContextualModels[ModelType];
+		if(const auto Usage = ModelUsages.Find(ModelType))
+		{
+			Usage->LastAccessTime = FPlatformTime::Seconds();
+			//The caller may change the model, it is measured again once idle
+			Usage->EstimatedMemorySize = INDEX_NONE;
+		}
+		return *ContextualModel;
 	}
 
 	return CreateContextualModel(ModelType);
 }
 
+UUIContextualModel* UWorldModelRepositorySubsystem::FindContextualModel(TSubclassOf<UUIContextualModel> ModelType) const
+{
+	const auto ContextualModel = ContextualModels.Find(ModelType);
+	return ContextualModel ? *ContextualModel : nullptr;
+}
+
+UUIContextualModel* UWorldModelRepositorySubsystem::AddModelReference(TSubclassOf<UUIContextualModel> ModelType, const UObject* User)
+{
+	const auto ContextualModel = GetContextualModel(ModelType);
+	if(!ContextualModel || !User) return ContextualModel;
+
+	if(const auto Usage = ModelUsages.Find(ModelType))
+	{
+		Usage->Users.AddUnique(User);
+	}
+
+	return ContextualModel;
+}
+
+void UWorldModelRepositorySubsystem::RemoveModelReference(TSubclassOf<UUIContextualModel> ModelType, const UObject* User)
+{
+	const auto Usage = ModelUsages.Find(ModelType);
+	if(!Usage) return;
+
+	Usage->Users.RemoveAllSwap([User](const TWeakObjectPtr<const UObject>& ModelUser)
+	{
+		return !ModelUser.IsValid() || ModelUser.Get() == User;
+	});
+	Usage->LastAccessTime = FPlatformTime::Seconds();
+}
+
+void UWorldModelRepositorySubsystem::RemoveAllModelReferences(const UObject* User)
+{
+	const double Now = FPlatformTime::Seconds();
+	for (auto& [ModelType, Usage] : ModelUsages)
+	{
+		if(Usage.Users.RemoveAllSwap([User](const TWeakObjectPtr<const UObject>& ModelUser)
+		{
+			return !ModelUser.IsValid() || ModelUser.Get() == User;
+		}) > 0)
+		{
+			Usage.LastAccessTime = Now;
+		}
+	}
+}
+
+void UWorldModelRepositorySubsystem::EvictIdleModels()
+{
+	if(ModelUsages.IsEmpty()) return;
+
+	const auto Settings = GetDefault<UMVVMLibrarySettings>();
+	const double Now = FPlatformTime::Seconds();
+
+	struct FIdleModel
+	{
+		UClass* ModelType;
+		double LastAccessTime;
+	};
+
+	TArray<FIdleModel> IdleModels;
+	TArray<UClass*> ExpiredModels;
+	for (auto& [ModelType, Usage] : ModelUsages)
+	{
+		if(Usage.HasLiveUsers()) continue;
+
+		if(Settings->ContextualModelIdleTimeout > 0.f && Now - Usage.LastAccessTime > Settings->ContextualModelIdleTimeout)
+		{
+			ExpiredModels.Add(ModelType);
+		}
+		else
+		{
+			IdleModels.Add({ModelType, Usage.LastAccessTime});
+		}
+	}
+
+	for (const auto ModelType : ExpiredModels)
+	{
+		EvictModel(ModelType);
+	}
+
+	if(Settings->IdleContextualModelBudgetMB <= 0.f || IdleModels.IsEmpty()) return;
+
+	const int64 Budget = static_cast<int64>(Settings->IdleContextualModelBudgetMB * 1024.0 * 1024.0);
+	int64 IdleMemorySize = 0;
+	TArray<int64> IdleModelSizes;
+	IdleModelSizes.Reserve(IdleModels.Num());
+
+	//Least recently used first
+	IdleModels.Sort([](const FIdleModel& A, const FIdleModel& B)
+	{
+		return A.LastAccessTime < B.LastAccessTime;
+	});
+	for (const auto& IdleModel : IdleModels)
+	{
+		//Measured once per idle period instead of on every pass
+		auto& Usage = ModelUsages[IdleModel.ModelType];
+		if(Usage.EstimatedMemorySize == INDEX_NONE)
+		{
+			const auto ContextualModel = ContextualModels.FindRef(IdleModel.ModelType);
+			Usage.EstimatedMemorySize = ContextualModel ? ContextualModel->GetEstimatedMemorySize() : 0;
+		}
+		IdleModelSizes.Add(Usage.EstimatedMemorySize);
+		IdleMemorySize += Usage.EstimatedMemorySize;
+	}
+
+	for (int32 Index = 0; Index < IdleModels.Num() && IdleMemorySize > Budget; ++Index)
+	{
+		EvictModel(IdleModels[Index].ModelType);
+		IdleMemorySize -= IdleModelSizes[Index];
+	}
+}
+
+void UWorldModelRepositorySubsystem::EvictModel(UClass* ModelType)
+{
+	ModelUsages.Remove(ModelType);
+
+	UUIContextualModel* ContextualModel = nullptr;
+	if(ContextualModels.RemoveAndCopyValue(ModelType, ContextualModel) && ContextualModel)
+	{
+		MVVM_HITCH_SCOPE(Teardown, ModelType);
+		ContextualModel->OnDestroyModel();
+	}
+}
+
 UUIContextualModel* UWorldModelRepositorySubsystem::CreateContextualModel(const TSubclassOf<UUIContextualModel>& ModelType)
 {
+	UUIContextualModel* NewModel = NewContextualModel(ModelType);
+	ContextualModels.Add(ModelType, NewModel);
+
+	{
+		MVVM_HITCH_SCOPE(ModelInitialization, ModelType);
+		NewModel->OnInitModel();
+	}
+
+	//The budget is enforced by the eviction timer only, creation never measures the idle models
+	if(NewModel->bCanBeEvicted)
+	{
+		ModelUsages.Add(ModelType).LastAccessTime = FPlatformTime::Seconds();
+	}
+
+	return NewModel;
+}
+
+UUIContextualModel* UWorldModelRepositorySubsystem::NewContextualModel(UClass* ModelType, uint64 EntityKey, AActor* EntityActor)
+{
+	MVVM_HITCH_SCOPE(ModelCreation, ModelType);
 	UUIContextualModel* NewModel = NewObject<UUIContextualModel>(this, ModelType);
+	NewModel->EntityKey = EntityKey;
+	NewModel->EntityActor = EntityActor;
 
 	const auto ModelRepository = GetModeRepositorySubsystem();
 	check(ModelRepository);
-	ContextualModels.Add(ModelType, NewModel);
+	NewModel->BindWorldContext(GetWorld());
 	NewModel->SetModelRepository(ModelRepository);
 	NewModel->SetWorldModelRepository(this);
 
+	return NewModel;
+}
+
+UUIContextualModel* UWorldModelRepositorySubsystem::K2_GetEntityModel(TSubclassOf<UUIContextualModel> ModelType, int64 Key)
+{
+	return GetEntityModel(MoveTemp(ModelType), static_cast<uint64>(Key));
+}
+
+bool UWorldModelRepositorySubsystem::K2_DestroyEntityModel(TSubclassOf<UUIContextualModel> ModelType, int64 Key)
+{
+	return DestroyEntityModel(MoveTemp(ModelType), static_cast<uint64>(Key));
+}
+
+void UWorldModelRepositorySubsystem::K2_GetEntityModels(TSubclassOf<UUIContextualModel> ModelType, TArray<UUIContextualModel*>& OutModels)
+{
+	const auto Models = GetEntityModels(MoveTemp(ModelType));
+	OutModels.Reset(Models.Num());
+	for (const auto& Model : Models)
+	{
+		OutModels.Add(Model);
+	}
+}
+
+UUIContextualModel* UWorldModelRepositorySubsystem::GetEntityModel(TSubclassOf<UUIContextualModel> ModelType, uint64 Key)
+{
+	if(!IsValid(ModelType)) return nullptr;
+
+	if(const auto Model = FindEntityModel(ModelType, Key))
+	{
+		return Model;
+	}
+
+	return CreateEntityModel(ModelType, Key, nullptr);
+}
+
+UUIContextualModel* UWorldModelRepositorySubsystem::CreateEntityModel(UClass* ModelType, uint64 Key, AActor* Actor)
+{
+	//Repository events of the new model may create other models, so the bucket is looked up afterwards
+	UUIContextualModel* NewModel = NewContextualModel(ModelType, Key, Actor);
+
+	auto& Bucket = EntityModels.FindOrAdd(ModelType);
+	Bucket.KeyToIndex.Add(Key, Bucket.Models.Add(NewModel));
+	Bucket.Keys.Add(Key);
+
+	MVVM_HITCH_SCOPE(ModelInitialization, ModelType);
 	NewModel->OnInitModel();
 
 	return NewModel;
 }
 
+UUIContextualModel* UWorldModelRepositorySubsystem::GetActorModel(TSubclassOf<UUIContextualModel> ModelType, AActor* Actor)
+{
+	if(!IsValid(Actor)) return nullptr;
+
+	const uint64 Key = MakeEntityKey(Actor);
+	if(const auto Model = FindEntityModel(ModelType, Key))
+	{
+		return Model;
+	}
+
+	if(!IsValid(ModelType)) return nullptr;
+
+	Actor->OnEndPlay.AddUniqueDynamic(this, &ThisClass::OnEntityActorEndPlay);
+	return CreateEntityModel(ModelType, Key, Actor);
+}
+
+UUIContextualModel* UWorldModelRepositorySubsystem::FindEntityModel(TSubclassOf<UUIContextualModel> ModelType, uint64 Key) const
+{
+	const auto Bucket = EntityModels.Find(ModelType);
+	const int32* Index = Bucket ? Bucket->KeyToIndex.Find(Key) : nullptr;
+	return Index ? Bucket->Models[*Index].Get() : nullptr;
+}
+
+bool UWorldModelRepositorySubsystem::DestroyEntityModel(TSubclassOf<UUIContextualModel> ModelType, uint64 Key)
+{
+	const auto Bucket = EntityModels.Find(ModelType);
+	int32 Index = INDEX_NONE;
+	if(!Bucket || !Bucket->KeyToIndex.RemoveAndCopyValue(Key, Index)) return false;
+
+	const auto Model = Bucket->Models[Index];
+	Bucket->Models.RemoveAtSwap(Index);
+	Bucket->Keys.RemoveAtSwap(Index);
+	if(Bucket->Keys.IsValidIndex(Index))
+	{
+		Bucket->KeyToIndex[Bucket->Keys[Index]] = Index;
+	}
+
+	if(Model)
+	{
+		MVVM_HITCH_SCOPE(Teardown, ModelType);
+		Model->OnDestroyModel();
+	}
+
+	return true;
+}
+
+TConstArrayView<TObjectPtr<UUIContextualModel>> UWorldModelRepositorySubsystem::GetEntityModels(TSubclassOf<UUIContextualModel> ModelType) const
+{
+	const auto Bucket = EntityModels.Find(ModelType);
+	return Bucket ? TConstArrayView<TObjectPtr<UUIContextualModel>>(Bucket->Models) : TConstArrayView<TObjectPtr<UUIContextualModel>>();
+}
+
+uint64 UWorldModelRepositorySubsystem::MakeEntityKey(const AActor* Actor)
+{
+	//Index and serial number, like FObjectKey, so a recycled object slot never matches an old key
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(Actor);
+	const int32 SerialNumber = GUObjectArray.AllocateSerialNumber(ObjectIndex);
+	return static_cast<uint64>(static_cast<uint32>(SerialNumber)) << 32 | static_cast<uint32>(ObjectIndex);
+}
+
+void UWorldModelRepositorySubsystem::OnEntityActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	const uint64 Key = MakeEntityKey(Actor);
+
+	TArray<UClass*, TInlineAllocator<8>> ModelTypes;
+	for (const auto& [ModelType, Bucket] : EntityModels)
+	{
+		if(Bucket.KeyToIndex.Contains(Key)) ModelTypes.Add(ModelType);
+	}
+
+	for (const auto ModelType : ModelTypes)
+	{
+		DestroyEntityModel(ModelType, Key);
+	}
+}
+
 UModelRepositorySubsystem* UWorldModelRepositorySubsystem::GetModeRepositorySubsystem() const
 {
 	if(ModelRepositorySubsystemCache.IsValid())
@@ -62,9 +394,9 @@ UModelRepositorySubsystem* UWorldModelRepositorySubsystem::GetModeRepositorySubs
 		return ModelRepositorySubsystemCache.Get();
 	}
 
-	if(GetWorld())
+	if(const auto GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
 	{
-		ModelRepositorySubsystemCache = GetWorld()->GetGameInstance()->GetSubsystem<UModelRepositorySubsystem>();
+		ModelRepositorySubsystemCache = GameInstance->GetSubsystem<UModelRepositorySubsystem>();
 		return ModelRepositorySubsystemCache.Get();
 	}
 
@@ -0,0 +1,181 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UISessionModel.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "UICatalogModel.generated.h"
+
+/**
+ * Record layout of a catalog file.
+ */
+UENUM(BlueprintType)
+enum class ECatalogLayout : uint8
+{
+	/** Records of equal stride sorted by id. Every record starts with its int64 id */
+	FixedStride,
+	/** Records of any size, found through a sorted index of ids and offsets */
+	Indexed,
+};
+
+/**
+ * Session model backed by a read-only binary catalog file instead of memory. The file is memory-mapped, so only the pages
+ * of the records that are read become resident, and StartSession only validates the header. Records are found by id with
+ * a binary search and decoded into a small LRU cache of RecordType values. The full set is never materialized.
+ * Build catalog files with WriteCatalogFile. Stage them as non-UFS files, files inside a pak can not be mapped
+ * and are read with regular file reads instead.
+ * Game thread only.
+ */
+UCLASS(Abstract, Blueprintable, BlueprintType)
+class MVVMLIBRARY_API UUICatalogModel : public UUISessionModel
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Catalog file, relative to the project content directory */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|Catalog")
+	FString CatalogPath;
+
+	/** Struct every record decodes into */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|Catalog")
+	TObjectPtr<UScriptStruct> RecordType = nullptr;
+
+	/** Decoded records kept in memory. The least recently used record is dropped first */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|Catalog", meta = (ClampMin = "1"))
+	int32 DecodedRecordCacheSize = 64;
+
+public:
+
+	virtual void BeginDestroy() override;
+
+	/**
+	 * @param Id Id of the record
+	 * @return Decoded record of RecordType or nullptr. Valid until the next record query
+	 */
+	const void* FindRecord(int64 Id);
+
+	/**
+	 * C++ template variant of FindRecord. T must be RecordType
+	 */
+	template<typename T>
+	const T* FindRecord(int64 Id)
+	{
+		check(RecordType == T::StaticStruct());
+		return static_cast<const T*>(FindRecord(Id));
+	}
+
+	/**
+	 * Visits the records with ids in [FirstId, LastId] in id order. Records are decoded one at a time through the cache.
+	 * @param Callback Return false to stop
+	 */
+	void ForEachRecordInRange(int64 FirstId, int64 LastId, TFunctionRef<bool(int64 Id, const void* Record)> Callback);
+
+	/**
+	 * Copies a record into the connected struct pin, which must be of RecordType.
+	 * @param Id Id of the record
+	 * @param OutRecord Copy of the record
+	 * @return Is the record found?
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, CustomThunk, Category = "MVVM|Catalog", meta=(CustomStructureParam = "OutRecord"))
+	bool GetRecord(int64 Id, int32& OutRecord);
+
+	/**
+	 * Ids in [FirstId, LastId] without decoding the records
+	 * @param MaxCount Maximum number of returned ids
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Catalog")
+	TArray<int64> GetRecordIdsInRange(int64 FirstId, int64 LastId, int32 MaxCount = 100) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Catalog")
+	bool ContainsRecord(int64 Id) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Catalog")
+	int32 GetRecordCount() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Catalog")
+	bool IsCatalogOpen() const;
+
+	/**
+	 * Writes a catalog file. Records are serialized with the binary layout of RecordType and sorted by id.
+	 * @param FilePath Target file
+	 * @param InRecordType Struct of the records
+	 * @param Ids Unique ids of the records
+	 * @param Records Values of InRecordType, one per id
+	 * @param Layout FixedStride pads every record to the largest one
+	 * @return Was the file written?
+	 */
+	static bool WriteCatalogFile(const FString& FilePath, const UScriptStruct* InRecordType, TConstArrayView<int64> Ids,
+		TConstArrayView<const void*> Records, ECatalogLayout Layout = ECatalogLayout::Indexed);
+
+protected:
+
+	virtual void StartSession() override;
+	virtual void EndSession() override;
+
+	/**
+	 * Decodes the bytes of a record. Override for custom record encodings.
+	 * @param Id Id of the record
+	 * @param Bytes Payload of the record, without the id of FixedStride records
+	 * @param OutRecord Initialized value of RecordType
+	 * @return Is the record decoded?
+	 */
+	virtual bool DecodeRecord(int64 Id, TConstArrayView<uint8> Bytes, void* OutRecord) const;
+
+	bool OpenCatalog();
+	void CloseCatalog();
+
+private:
+
+	DECLARE_FUNCTION(execGetRecord);
+
+	struct FCachedRecord
+	{
+		int64 Id = 0;
+		void* Memory = nullptr;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		bool bIsValid = false;
+	};
+
+	/** @return Index of the first record with an id not less than Id */
+	int32 LowerBound(int64 Id) const;
+	int64 GetIdAt(int32 Index) const;
+
+	/** @return Payload of the record at Index. Valid until the next read */
+	TConstArrayView<uint8> GetPayloadAt(int32 Index);
+
+	/** Copies file bytes from the mapping or, when the file is not mapped, through a file read */
+	bool ReadBytes(uint64 Offset, void* Destination, int64 Size) const;
+
+	void TouchCachedRecord(int32 Slot);
+	void UnlinkCachedRecord(int32 Slot);
+	void EmptyCache();
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** Start of the mapped file, nullptr when reading through FileHandle */
+	const uint8* MappedData = nullptr;
+	uint64 FileSize = 0;
+
+	ECatalogLayout Layout = ECatalogLayout::Indexed;
+	uint32 RecordStride = 0;
+	int32 RecordCount = 0;
+	uint64 IndexOffset = 0;
+	uint64 DataOffset = 0;
+
+	/** Payload of the last record read through FileHandle */
+	TArray<uint8> ReadBuffer;
+
+	TArray<FCachedRecord> CachedRecords;
+	TMap<int64, int32> CachedRecordSlots;
+	int32 MostRecentSlot = INDEX_NONE;
+	int32 LeastRecentSlot = INDEX_NONE;
+};
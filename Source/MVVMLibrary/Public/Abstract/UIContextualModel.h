@@ -7,8 +7,10 @@
 
 #include "CoreMinimal.h"
 #include "ObjectWithWorldContext.h"
+#include "UIModelTypes.h"
 #include "UIContextualModel.generated.h"
 
+class AActor;
 class UModelRepositorySubsystem;
 class UWorldModelRepositorySubsystem;
 
@@ -20,13 +22,45 @@ class MVVMLIBRARY_API UUIContextualModel : public UObjectWithWorldContext
 {
 	GENERATED_BODY()
 
+public:
+
+	/**
+	 * Broadcasted when an observable field of the model has changed. See NotifyFieldChanged.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "MVVM|ContextualModel")
+	FOnModelFieldChangedDelegate OnFieldChanged;
+
+protected:
+
+	/**
+	 * Lets the repository destroy the model while nothing references it, see UWorldModelRepositorySubsystem::AddModelReference.
+	 * The next GetContextualModel creates it again, so the model must be able to rebuild its data in OnInitModel.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|ContextualModel")
+	bool bCanBeEvicted = false;
+
+	/**
+	 * Memory the model keeps, used by the eviction budget. Base implementation counts the memory allocated by the containers
+	 * and properties of the model (FArchiveCountMem::GetMax), measured once per idle period.
+	 * Override it when the model owns memory outside of UPROPERTYs.
+	 */
+	virtual int64 GetEstimatedMemorySize() const;
+
 private:
 
+	/** Bit per K2 event that is implemented in Blueprint. Resolved on the first dispatch */
+	TOptional<uint32> ImplementedBlueprintEvents;
+
 	UPROPERTY()
 	TWeakObjectPtr<UWorldModelRepositorySubsystem> WorldModelRepository = nullptr;
 	UPROPERTY()
 	TWeakObjectPtr<UModelRepositorySubsystem> ModelRepository = nullptr;
 
+	/** Key of an entity model, see UWorldModelRepositorySubsystem::GetEntityModel */
+	uint64 EntityKey = 0;
+	UPROPERTY()
+	TWeakObjectPtr<AActor> EntityActor = nullptr;
+
 protected:
 
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ContextualModel")
@@ -34,6 +68,26 @@ protected:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ContextualModel")
 	UModelRepositorySubsystem* GetModelRepository() const;
 
+	/**
+	 * Key of the entity the model belongs to. 0 for the single model of a class
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ContextualModel")
+	int64 GetEntityKey() const;
+
+	/**
+	 * Actor the model belongs to, if it was created with GetActorModel
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ContextualModel")
+	AActor* GetEntityActor() const;
+
+	/**
+	 * Marks an observable field as changed and broadcasts OnFieldChanged. Call it after the new value has been written.
+	 * Changes reported here are captured by the model mutation recorder.
+	 * @param FieldName Name of the changed UPROPERTY of this model
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ContextualModel")
+	void NotifyFieldChanged(FName FieldName);
+
 	/**
 	 * Should be overridden in C++ heirs
 	 * @param InWorldModelRepository 
@@ -81,11 +135,20 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ContextualModel", meta=(DisplayName = "OnInitModel", ScriptName = "OnInitModel"))
 	void K2_OnInitModel();
 	/**
-	 * Event called when changing scene / shutdown game.
+	 * Event called when changing scene / shutdown game, or when the idle model is evicted.
 	 * Do not call this event yourself. For C++ heirs there is a virtual method without K2 prefix
 	 */
 	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ContextualModel", meta=(DisplayName = "OnDestroyModel", ScriptName = "OnDestroyModel"))
 	void K2_OnDestroyModel();
 
 	friend class UWorldModelRepositorySubsystem;
+	friend class UModelMutationRecorderSubsystem;
+
+private:
+
+	/**
+	 * Lets pure C++ heirs skip the ProcessEvent round-trip of K2 events that are not implemented in Blueprint.
+	 * @param Event Index of the event in its name table
+	 */
+	bool IsImplementedInBlueprint(uint32 Event);
 };
@@ -0,0 +1,48 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UILightModel.generated.h"
+
+class UModelRepositorySubsystem;
+class UWorldModelRepositorySubsystem;
+
+/**
+ * Services available to a light model in its lifecycle hooks.
+ */
+struct FUILightModelContext
+{
+	UModelRepositorySubsystem* ModelRepository = nullptr;
+	/** nullptr for light models of the session repository */
+	UWorldModelRepositorySubsystem* WorldModelRepository = nullptr;
+	uint64 Key = 0;
+};
+
+/**
+ * In the mvvm paradigm, a light model stores high-count data (per item, per quest, per NPC records) without UObject overhead.
+ * Heirs are USTRUCTs stored by value in contiguous per-type arrays of a repository, keyed by a 64-bit id, and never scanned by GC.
+ * So a light model must not hold strong UObject references; use weak or soft pointers.
+ * Instances may move in memory when models of the same type are created or destroyed: keep the key, not the pointer.
+ */
+USTRUCT(BlueprintType)
+struct MVVMLIBRARY_API FUILightModel
+{
+	GENERATED_BODY()
+
+	virtual ~FUILightModel() = default;
+
+	/**
+	 * Called when the model is created in a repository
+	 * @param Context Repositories and key of the model
+	 */
+	virtual void OnInitModel(const FUILightModelContext& Context) {}
+
+	/**
+	 * Called when the model is destroyed, the repository is closed or the scene is changed
+	 */
+	virtual void OnDestroyModel() {}
+};
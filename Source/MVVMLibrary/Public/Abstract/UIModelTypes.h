@@ -0,0 +1,29 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UIModelTypes.generated.h"
+
+/**
+ * Broadcasted by a model when one of its observable fields has changed.
+ * FieldName is the name of the changed UPROPERTY.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnModelFieldChangedDelegate, FName, FieldName);
+
+/**
+ * When a session model publishes a snapshot of its state for worker threads. See UUISessionModel::PublishSnapshot.
+ */
+UENUM(BlueprintType)
+enum class EModelSnapshotPolicy : uint8
+{
+	/** Only when the model calls PublishSnapshot itself */
+	Manual,
+	/** Once at the end of a frame in which NotifyFieldChanged was called */
+	EndOfFrame,
+	/** On every NotifyFieldChanged */
+	OnChange,
+};
@@ -7,6 +7,7 @@
 
 #include "CoreMinimal.h"
 #include "ObjectWithWorldContext.h"
+#include "UIModelTypes.h"
 #include "UISessionModel.generated.h"
 
 class UModelRepositorySubsystem;
@@ -19,8 +20,28 @@ class MVVMLIBRARY_API UUISessionModel : public UObjectWithWorldContext
 {
 	GENERATED_BODY()
 
+public:
+
+	/**
+	 * Broadcasted when an observable field of the model has changed. See NotifyFieldChanged.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "MVVM|SessionModel")
+	FOnModelFieldChangedDelegate OnFieldChanged;
+
+protected:
+
+	/** When the state is published for worker threads. Used by heirs that override PublishSnapshot */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|SessionModel")
+	EModelSnapshotPolicy SnapshotPolicy = EModelSnapshotPolicy::Manual;
+
 private:
 
+	/** Is a snapshot publish pending for the end of the frame */
+	bool bIsSnapshotDirty = false;
+
+	/** Bit per K2 event that is implemented in Blueprint. Resolved on the first dispatch */
+	TOptional<uint32> ImplementedBlueprintEvents;
+
 	UPROPERTY()
 	TWeakObjectPtr<UModelRepositorySubsystem> ModelRepository = nullptr;
 
@@ -29,6 +50,14 @@ protected:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|SessionModel")
 	UModelRepositorySubsystem* GetModelRepository() const;
 
+	/**
+	 * Marks an observable field as changed and broadcasts OnFieldChanged. Call it after the new value has been written.
+	 * Changes reported here are captured by the model mutation recorder.
+	 * @param FieldName Name of the changed UPROPERTY of this model
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|SessionModel")
+	void NotifyFieldChanged(FName FieldName);
+
 	/**
 	 * Should be overridden in C++ heirs
 	 * @param InModelRepository 
@@ -41,6 +70,13 @@ protected:
 	 */
 	UFUNCTION()
 	virtual void StartSession();
+
+	/**
+	 * Should be overridden in C++ heirs that keep a TModelSnapshot: publishes a copy of the live state to it.
+	 * Called by SnapshotPolicy and once after StartSession. Game thread only.
+	 */
+	virtual void PublishSnapshot();
+
 	/**
 	 * Should be overridden in C++ heirs
 	 */
@@ -72,4 +108,13 @@ protected:
 	void K2_EndSession();
 
 	friend class UModelRepositorySubsystem;
+	friend class UModelMutationRecorderSubsystem;
+
+private:
+
+	/**
+	 * Lets pure C++ heirs skip the ProcessEvent round-trip of K2 events that are not implemented in Blueprint.
+	 * @param Event Index of the event in its name table
+	 */
+	bool IsImplementedInBlueprint(uint32 Event);
 };
@@ -0,0 +1,51 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Computes once per class which BlueprintImplementableEvents are implemented in Blueprint,
+ * so native code can skip the ProcessEvent round-trip for events nobody overrides.
+ * Game thread only.
+ */
+class MVVMLIBRARY_API FBlueprintEventMask
+{
+public:
+
+	/**
+	 * @param Class Class of the instance that dispatches the events
+	 * @param EventNames Events in bit order, at most 32. Must point to static storage, it is part of the cache key
+	 * @return Mask where bit N is set when EventNames[N] is implemented by a Blueprint class
+	 */
+	static uint32 Get(const UClass* Class, TConstArrayView<FName> EventNames);
+
+	/**
+	 * Tests one event against the mask of an instance, resolving the mask with Get on the first call.
+	 * @param InstanceMask Mask cached by the instance
+	 * @param Class Class of the instance that dispatches the events
+	 * @param EventNames Events in bit order, at most 32. Must point to static storage
+	 * @param EventIndex Index of the event in EventNames, which is its bit in the mask
+	 * @return Is the event implemented by a Blueprint class?
+	 */
+	static bool IsImplemented(TOptional<uint32>& InstanceMask, const UClass* Class, TConstArrayView<FName> EventNames, uint32 EventIndex)
+	{
+		checkSlow(EventIndex < static_cast<uint32>(EventNames.Num()));
+
+		if(!InstanceMask.IsSet())
+		{
+			InstanceMask = Get(Class, EventNames);
+		}
+
+		return (InstanceMask.GetValue() & (1u << EventIndex)) != 0;
+	}
+
+private:
+
+	/** Keyed by FObjectKey, so a class unloaded and replaced at the same address never reuses a stale mask */
+	static TMap<TPair<FObjectKey, const FName*>, uint32> CachedMasks;
+};
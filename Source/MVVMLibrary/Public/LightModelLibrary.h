@@ -0,0 +1,75 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "LightModelLibrary.generated.h"
+
+/**
+ * Repository that stores a light model.
+ */
+UENUM(BlueprintType)
+enum class ELightModelScope : uint8
+{
+	/** UModelRepositorySubsystem, lives during all runtime */
+	Session,
+	/** UWorldModelRepositorySubsystem, lives during one scene */
+	World,
+};
+
+/**
+ * Thin Blueprint access to light models. Blueprints work on copies: read a model, change the copy, write it back.
+ */
+UCLASS()
+class MVVMLIBRARY_API ULightModelLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Copies a light model out of its repository, creating the model when missing.
+	 * The type of the model is taken from the connected struct pin and must be an heir of FUILightModel.
+	 * @param Scope Repository of the model
+	 * @param Key Id of the model
+	 * @param OutModel Copy of the model
+	 * @return Is the model read?
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, CustomThunk, Category = "MVVM|LightModel", meta=(WorldContext = "WorldContextObject", CustomStructureParam = "OutModel"))
+	static bool GetLightModel(const UObject* WorldContextObject, ELightModelScope Scope, int64 Key, int32& OutModel);
+
+	/**
+	 * Writes a copy back into the light model, creating the model when missing.
+	 * @param Scope Repository of the model
+	 * @param Key Id of the model
+	 * @param Model New value of the model
+	 * @return Is the model written?
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, CustomThunk, Category = "MVVM|LightModel", meta=(WorldContext = "WorldContextObject", CustomStructureParam = "Model", AutoCreateRefTerm = "Model"))
+	static bool SetLightModel(const UObject* WorldContextObject, ELightModelScope Scope, int64 Key, const int32& Model);
+
+	/**
+	 * Destroys a light model.
+	 * @param Scope Repository of the model
+	 * @param ModelType Heir of FUILightModel
+	 * @param Key Id of the model
+	 * @return Was the model stored?
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|LightModel", meta=(WorldContext = "WorldContextObject"))
+	static bool DestroyLightModel(const UObject* WorldContextObject, ELightModelScope Scope, UScriptStruct* ModelType, int64 Key);
+
+private:
+
+	DECLARE_FUNCTION(execGetLightModel);
+	DECLARE_FUNCTION(execSetLightModel);
+
+	/**
+	 * Copies a light model from or into a Blueprint struct value.
+	 * @param bRead Direction: model -> value if true
+	 */
+	static bool CopyLightModel(const UObject* WorldContextObject, ELightModelScope Scope, uint64 Key, const FStructProperty* ValueProperty, void* Value, bool bRead);
+};
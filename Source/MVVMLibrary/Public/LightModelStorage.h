@@ -0,0 +1,131 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abstract/UILightModel.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Dense storage of light models. Models of one struct type live by value in one contiguous buffer,
+ * indexed by key; removal moves the last model into the hole. Not reflected, so GC never scans it.
+ * Owned by the session and the world repository, reached through their GetLightModels. Game thread only.
+ */
+class MVVMLIBRARY_API FLightModelStorage
+{
+public:
+
+	FLightModelStorage() = default;
+	~FLightModelStorage();
+
+	UE_NONCOPYABLE(FLightModelStorage);
+
+	/**
+	 * Sets the repositories passed to OnInitModel. Called by the owning repository on initialization
+	 */
+	void SetContext(UModelRepositorySubsystem* ModelRepository, UWorldModelRepositorySubsystem* WorldModelRepository);
+
+	/**
+	 * Gives a light model, creating it and calling OnInitModel when missing.
+	 * @param ModelType Heir of FUILightModel
+	 * @param Key Id of the model
+	 * @return Model or nullptr. Do not keep the pointer: models move when others of the type are created or destroyed
+	 */
+	FUILightModel* Get(const UScriptStruct* ModelType, uint64 Key);
+
+	/**
+	 * C++ template variant of Get method
+	 * @tparam T Heir of FUILightModel
+	 */
+	template<class T>
+	T* Get(uint64 Key)
+	{
+		static_assert(TIsDerivedFrom<T, FUILightModel>::IsDerived, "Get can only be used with FUILightModel heirs");
+
+		return static_cast<T*>(Get(T::StaticStruct(), Key));
+	}
+
+	/**
+	 * Gives a light model without creating it.
+	 * @return Model or nullptr
+	 */
+	FUILightModel* Find(const UScriptStruct* ModelType, uint64 Key);
+
+	template<class T>
+	T* Find(uint64 Key)
+	{
+		static_assert(TIsDerivedFrom<T, FUILightModel>::IsDerived, "Find can only be used with FUILightModel heirs");
+
+		return static_cast<T*>(Find(T::StaticStruct(), Key));
+	}
+
+	/**
+	 * Calls OnDestroyModel and destroys the model. The last model of the type is moved into its slot.
+	 * @return Was the model stored?
+	 */
+	bool Remove(const UScriptStruct* ModelType, uint64 Key);
+
+	template<class T>
+	bool Remove(uint64 Key)
+	{
+		static_assert(TIsDerivedFrom<T, FUILightModel>::IsDerived, "Remove can only be used with FUILightModel heirs");
+
+		return Remove(T::StaticStruct(), Key);
+	}
+
+	/** Calls OnDestroyModel on every model and destroys all of them */
+	void Empty();
+
+	int32 Num(const UScriptStruct* ModelType) const;
+
+	/**
+	 * Visits all models of one type in one sweep over contiguous memory.
+	 * Do not create or remove models of that type from the callback.
+	 */
+	void ForEach(const UScriptStruct* ModelType, TFunctionRef<void(uint64 Key, FUILightModel& Model)> Callback);
+
+	template<class T>
+	void ForEach(TFunctionRef<void(uint64 Key, T& Model)> Callback)
+	{
+		static_assert(TIsDerivedFrom<T, FUILightModel>::IsDerived, "ForEach can only be used with FUILightModel heirs");
+
+		ForEach(T::StaticStruct(), [&Callback](uint64 Key, FUILightModel& Model)
+		{
+			Callback(Key, static_cast<T&>(Model));
+		});
+	}
+
+private:
+
+	struct FBucket
+	{
+		const UScriptStruct* ModelType = nullptr;
+		int32 Stride = 0;
+		TArray<uint8, TAlignedHeapAllocator<16>> Memory;
+		TArray<uint64> Keys;
+		TMap<uint64, int32> KeyToIndex;
+
+		FUILightModel* GetModel(int32 Index)
+		{
+			return reinterpret_cast<FUILightModel*>(Memory.GetData() + Index * Stride);
+		}
+	};
+
+	/**
+	 * Gives the model, default-constructing it when missing. OnInitModel is not called here.
+	 * @param bOutCreated Was the model created by this call?
+	 * @return Model or nullptr when ModelType is not a light model
+	 */
+	FUILightModel* FindOrAdd(const UScriptStruct* ModelType, uint64 Key, bool& bOutCreated);
+
+	FBucket* FindOrAddBucket(const UScriptStruct* ModelType);
+	void RemoveAt(FBucket& Bucket, int32 Index);
+
+	TMap<FObjectKey, FBucket> Buckets;
+
+	/** Passed to OnInitModel with the key filled in. The repositories own this storage and outlive it */
+	FUILightModelContext Context;
+};
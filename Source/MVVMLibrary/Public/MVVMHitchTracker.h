@@ -0,0 +1,150 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef WITH_MVVM_HITCH_TRACKER
+#define WITH_MVVM_HITCH_TRACKER !UE_BUILD_SHIPPING
+#endif
+
+/**
+ * Kind of MVVM work measured by the hitch tracker.
+ */
+enum class EMVVMWorkType : uint8
+{
+	ViewCreation,
+	ViewInitialization,
+	ViewModelCreation,
+	ModelCreation,
+	ModelInitialization,
+	Teardown,
+	Num
+};
+
+MVVMLIBRARY_API const TCHAR* LexToString(EMVVMWorkType WorkType);
+
+#if WITH_MVVM_HITCH_TRACKER
+
+/**
+ * Attributes frame hitches to MVVM work. Scopes accumulate their exclusive time per class and work type during a frame.
+ * At the end of a frame every sample is added to a per-class histogram, and when the MVVM time of the frame exceeds
+ * HitchThresholdMs of the plugin settings a compact breakdown is logged. Histograms can be dumped to CSV with MVVM.Hitch.DumpCsv.
+ * Game thread only.
+ */
+class MVVMLIBRARY_API FMVVMHitchTracker
+{
+public:
+
+	static void Startup();
+	static void Shutdown();
+
+	/** @return Tracker or nullptr when tracking is disabled or not called from the game thread */
+	static FMVVMHitchTracker* GetActive();
+
+	/** @return Tracker between Startup and Shutdown, also while tracking is disabled, so collected histograms stay reachable */
+	static FMVVMHitchTracker* Get();
+
+	void BeginScope();
+	void EndScope(EMVVMWorkType WorkType, const UStruct* Type, uint64 InclusiveCycles);
+
+	/**
+	 * Writes one row per class and work type: sample count, hitch frames, total, max and histogram buckets.
+	 * @param FilePath Target file. Empty == Saved/Profiling/MVVM/Hitches-<time>.csv
+	 * @return Was the file written?
+	 */
+	bool DumpCsv(const FString& FilePath) const;
+	void ResetHistograms();
+
+private:
+
+	static constexpr int32 NumBuckets = 9;
+
+	/** Upper bounds of the histogram buckets in milliseconds. The last bucket is open */
+	static constexpr double BucketBoundsMs[NumBuckets - 1] = { 0.1, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 33.0 };
+
+	struct FFrameSample
+	{
+		FName TypeName;
+		EMVVMWorkType WorkType = EMVVMWorkType::Num;
+		uint64 Cycles = 0;
+		int32 Count = 0;
+	};
+
+	struct FHistogram
+	{
+		int32 Samples = 0;
+		int32 HitchFrames = 0;
+		double TotalMs = 0.0;
+		double MaxMs = 0.0;
+		double HitchMs = 0.0;
+		int32 Buckets[NumBuckets] = {};
+	};
+
+	void OnEndFrame();
+
+	FDelegateHandle EndFrameHandle;
+
+	/** Threshold cached from the plugin settings at the end of every frame. 0 disables tracking */
+	double ThresholdMs = 0.0;
+
+	/** Child time of every open scope, so nested work is not counted twice */
+	TArray<uint64, TInlineAllocator<16>> ScopeChildCycles;
+
+	TArray<FFrameSample, TInlineAllocator<16>> FrameSamples;
+
+	TMap<TPair<FName, EMVVMWorkType>, FHistogram> Histograms;
+
+	static FMVVMHitchTracker* Instance;
+};
+
+/**
+ * Measures the enclosing scope for the hitch tracker. Use MVVM_HITCH_SCOPE.
+ */
+struct FMVVMHitchScope
+{
+	FMVVMHitchScope(EMVVMWorkType InWorkType, const UStruct* InType)
+		: Tracker(FMVVMHitchTracker::GetActive())
+		, Type(InType)
+		, WorkType(InWorkType)
+	{
+		if(Tracker)
+		{
+			Tracker->BeginScope();
+			StartCycles = FPlatformTime::Cycles64();
+		}
+	}
+
+	~FMVVMHitchScope()
+	{
+		if(Tracker)
+		{
+			Tracker->EndScope(WorkType, Type, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+	UE_NONCOPYABLE(FMVVMHitchScope);
+
+private:
+
+	FMVVMHitchTracker* Tracker;
+	const UStruct* Type;
+	uint64 StartCycles = 0;
+	EMVVMWorkType WorkType;
+};
+
+/**
+ * Attributes the time of the enclosing scope to a class
+ * @param WorkType Member of EMVVMWorkType
+ * @param Type Class or struct the work is done for
+ */
+#define MVVM_HITCH_SCOPE(WorkType, Type) const FMVVMHitchScope PREPROCESSOR_JOIN(MVVMHitchScope_, __LINE__)(EMVVMWorkType::WorkType, Type)
+
+#else
+
+#define MVVM_HITCH_SCOPE(WorkType, Type)
+
+#endif
@@ -0,0 +1,50 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "MVVMLibrarySettings.generated.h"
+
+/**
+ * Project-wide settings of the model layer of the MVVM Library plugin. Edited in Project Settings -> Plugins -> MVVM Library.
+ * Settings of windows, views and pop-ups live in UMVVMLibraryUISettings of the UI module.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "MVVM Library"))
+class MVVMLIBRARY_API UMVVMLibrarySettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	UMVVMLibrarySettings();
+
+	/**
+	 * Memory that idle evictable contextual models may keep. The least recently used ones are evicted above it.
+	 * 0 disables the budget.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Contextual Model Eviction", meta = (ClampMin = "0", Units = "MB"))
+	float IdleContextualModelBudgetMB = 0.f;
+
+	/**
+	 * Evictable contextual models that stay unreferenced for longer are evicted. 0 disables idle timeout.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Contextual Model Eviction", meta = (ClampMin = "0", Units = "s"))
+	float ContextualModelIdleTimeout = 0.f;
+
+	/**
+	 * How often the repository looks for models to evict. The budget is also checked when a model is created.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Contextual Model Eviction", meta = (ClampMin = "0.1", Units = "s"))
+	float ContextualModelEvictionInterval = 5.f;
+
+	/**
+	 * Frames in which view, viewmodel and model creation, initialization and teardown take longer are logged with a per-class breakdown.
+	 * While above 0, per-class histograms are kept for MVVM.Hitch.DumpCsv. 0 == tracking disabled. Not available in Shipping builds.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Hitch Tracking", meta = (ClampMin = "0", Units = "ms"))
+	float HitchThresholdMs = 0.f;
+};
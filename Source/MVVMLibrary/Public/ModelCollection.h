@@ -0,0 +1,408 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+
+/**
+ * Order-statistic treap over element ids. Every node knows the size of its subtree, so insertion, removal,
+ * the position of an element and the element at a position are O(log n) expected.
+ * Elements are compared by a callback, the tree stores no values. Game thread only.
+ */
+class MVVMLIBRARY_API FOrderStatisticTree
+{
+public:
+
+	/** @return Must A be placed before B. A strict total order */
+	using FLess = TFunctionRef<bool(int32 A, int32 B)>;
+
+	/**
+	 * @param Element Non-negative id not in the tree
+	 * @param Less Order of the ids in the tree
+	 */
+	void Insert(int32 Element, FLess Less);
+	void Remove(int32 Element);
+	bool Contains(int32 Element) const;
+
+	/** @return Position of the element or INDEX_NONE */
+	int32 IndexOf(int32 Element) const;
+
+	/** @return Element at a position or INDEX_NONE */
+	int32 GetAt(int32 Position) const;
+
+	/**
+	 * Visits up to Count elements in order, starting at Start. O(log n + Count)
+	 */
+	void ForEachInRange(int32 Start, int32 Count, TFunctionRef<void(int32 Element)> Callback) const;
+
+	int32 Num() const;
+	void Reset();
+
+private:
+
+	struct FNode
+	{
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+		int32 Parent = INDEX_NONE;
+		int32 Size = 0;
+		uint32 Priority = 0;
+		bool bIsLinked = false;
+	};
+
+	int32 SizeOf(int32 Node) const;
+
+	/** Recomputes the size of a node and links its children back to it */
+	void Update(int32 Node);
+
+	/** Splits a subtree into the elements for which GoesLeft is true and the rest. GoesLeft must be monotonic in order */
+	void SplitBy(int32 Node, TFunctionRef<bool(int32)> GoesLeft, int32& OutLeft, int32& OutRight);
+
+	/** Splits a subtree into its first Count elements and the rest */
+	void SplitAt(int32 Node, int32 Count, int32& OutLeft, int32& OutRight);
+
+	int32 Merge(int32 Left, int32 Right);
+
+	/** @return Next element in order or INDEX_NONE */
+	int32 Next(int32 Node) const;
+
+	TArray<FNode> Nodes;
+	int32 Root = INDEX_NONE;
+	uint32 PrioritySeed = 0x9E3779B9u;
+};
+
+/**
+ * Keyed collection of entries for collection models, e.g. an inventory or a friend list, with registered secondary
+ * indices: sort orders with optional filters that are kept up to date on every Set, Update and Remove in O(log n)
+ * per index. Viewmodels page through an index (ForEachInPage, GetAt, IndexOf) instead of re-sorting and re-filtering the
+ * whole array on every change. Changing the filter or the order of an index rebuilds only that index.
+ * Declare it as a member of a model. Game thread only.
+ * @tparam TEntry Value of an entry
+ */
+template<typename TEntry>
+class TModelCollection
+{
+public:
+
+	/** @return Must A be placed before B. Entries that are equal by it keep the order of their keys */
+	using FLess = TFunction<bool(const TEntry& A, const TEntry& B)>;
+	using FFilter = TFunction<bool(const TEntry& Entry)>;
+
+	/**
+	 * Broadcasted for every index an entry moved in. INDEX_NONE old position == inserted, new == removed.
+	 * Equal positions mean the entry changed in place.
+	 * Fired while the indices are being updated: listeners may read the notified index, other indices can still miss the entry.
+	 * Changing the collection from a listener (Set, Update, Remove, Empty or the indices) asserts, defer such changes.
+	 */
+	DECLARE_MULTICAST_DELEGATE_FourParams(FOnIndexChanged, FName /*IndexName*/, int64 /*Key*/, int32 /*OldPosition*/, int32 /*NewPosition*/);
+	FOnIndexChanged OnIndexChanged;
+
+	TModelCollection() = default;
+
+	TModelCollection(const TModelCollection&) = delete;
+	TModelCollection& operator=(const TModelCollection&) = delete;
+
+	/**
+	 * Registers an index and builds it. O(n log n) once
+	 * @param Name Id of the index
+	 * @param Less Sort order
+	 * @param Filter Entries in the index. nullptr == all
+	 */
+	void AddIndex(FName Name, FLess Less, FFilter Filter = nullptr)
+	{
+		CheckNotBroadcasting();
+		check(Less && !FindIndex(Name));
+
+		auto& Index = Indices.AddDefaulted_GetRef();
+		Index.Name = Name;
+		Index.Less = MoveTemp(Less);
+		Index.Filter = MoveTemp(Filter);
+		RebuildIndex(Index);
+	}
+
+	void RemoveIndex(FName Name)
+	{
+		CheckNotBroadcasting();
+		Indices.RemoveAll([Name](const FIndex& Index)
+		{
+			return Index.Name == Name;
+		});
+	}
+
+	/**
+	 * Replaces the filter of an index, e.g. on a search keystroke, and rebuilds only that index
+	 */
+	void SetIndexFilter(FName Name, FFilter Filter)
+	{
+		CheckNotBroadcasting();
+		if(const auto Index = FindIndex(Name))
+		{
+			Index->Filter = MoveTemp(Filter);
+			RebuildIndex(*Index);
+		}
+	}
+
+	void SetIndexOrder(FName Name, FLess Less)
+	{
+		CheckNotBroadcasting();
+		check(Less);
+		if(const auto Index = FindIndex(Name))
+		{
+			Index->Less = MoveTemp(Less);
+			RebuildIndex(*Index);
+		}
+	}
+
+	/**
+	 * Adds an entry or replaces the entry of the key
+	 */
+	void Set(int64 Key, TEntry Entry)
+	{
+		CheckNotBroadcasting();
+		if(const int32* Slot = Slots.Find(Key))
+		{
+			UpdateSlot(*Slot, [&Entry](TEntry& Existing)
+			{
+				Existing = MoveTemp(Entry);
+			});
+			return;
+		}
+
+		const int32 Slot = Entries.Add(FSlot{ Key, MoveTemp(Entry) });
+		Slots.Add(Key, Slot);
+
+		for (auto& Index : Indices)
+		{
+			if(Passes(Index, Slot))
+			{
+				InsertIntoIndex(Index, Slot);
+				Broadcast(Index, Key, INDEX_NONE, Index.Tree.IndexOf(Slot));
+			}
+		}
+	}
+
+	/**
+	 * Changes an entry in place and moves it in every index. O(log n) per index
+	 * @return Was the key found?
+	 */
+	bool Update(int64 Key, TFunctionRef<void(TEntry& Entry)> Mutator)
+	{
+		CheckNotBroadcasting();
+		const int32* Slot = Slots.Find(Key);
+		if(!Slot) return false;
+
+		UpdateSlot(*Slot, Mutator);
+		return true;
+	}
+
+	bool Remove(int64 Key)
+	{
+		CheckNotBroadcasting();
+		int32 Slot = INDEX_NONE;
+		if(!Slots.RemoveAndCopyValue(Key, Slot)) return false;
+
+		for (auto& Index : Indices)
+		{
+			const int32 Position = Index.Tree.IndexOf(Slot);
+			if(Position != INDEX_NONE)
+			{
+				Index.Tree.Remove(Slot);
+				Broadcast(Index, Key, Position, INDEX_NONE);
+			}
+		}
+
+		Entries.RemoveAt(Slot);
+		return true;
+	}
+
+	void Empty()
+	{
+		CheckNotBroadcasting();
+		Entries.Empty();
+		Slots.Empty();
+		for (auto& Index : Indices)
+		{
+			Index.Tree.Reset();
+		}
+	}
+
+	const TEntry* Find(int64 Key) const
+	{
+		const int32* Slot = Slots.Find(Key);
+		return Slot ? &Entries[*Slot].Entry : nullptr;
+	}
+
+	bool Contains(int64 Key) const
+	{
+		return Slots.Contains(Key);
+	}
+
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+	/** @return Number of entries in the index or 0 when it is not registered */
+	int32 NumInIndex(FName IndexName) const
+	{
+		const auto Index = FindIndex(IndexName);
+		return Index ? Index->Tree.Num() : 0;
+	}
+
+	/** @return Entry at a position of the index or nullptr */
+	const TEntry* GetAt(FName IndexName, int32 Position, int64* OutKey = nullptr) const
+	{
+		const auto Index = FindIndex(IndexName);
+		const int32 Slot = Index ? Index->Tree.GetAt(Position) : INDEX_NONE;
+		if(Slot == INDEX_NONE) return nullptr;
+
+		if(OutKey)
+		{
+			*OutKey = Entries[Slot].Key;
+		}
+		return &Entries[Slot].Entry;
+	}
+
+	/** @return Position of the key in the index or INDEX_NONE when it is filtered out */
+	int32 IndexOf(FName IndexName, int64 Key) const
+	{
+		const auto Index = FindIndex(IndexName);
+		const int32* Slot = Slots.Find(Key);
+		return Index && Slot ? Index->Tree.IndexOf(*Slot) : INDEX_NONE;
+	}
+
+	/**
+	 * Visits a page of the index in order. O(log n + Count)
+	 * @param Start Position of the first entry
+	 * @param Count Maximum number of visited entries
+	 */
+	void ForEachInPage(FName IndexName, int32 Start, int32 Count, TFunctionRef<void(int64 Key, const TEntry& Entry)> Callback) const
+	{
+		const auto Index = FindIndex(IndexName);
+		if(!Index) return;
+
+		Index->Tree.ForEachInRange(Start, Count, [this, &Callback](int32 Slot)
+		{
+			Callback(Entries[Slot].Key, Entries[Slot].Entry);
+		});
+	}
+
+private:
+
+	struct FSlot
+	{
+		int64 Key = 0;
+		TEntry Entry;
+	};
+
+	struct FIndex
+	{
+		FName Name;
+		FLess Less;
+		FFilter Filter;
+		FOrderStatisticTree Tree;
+	};
+
+	FIndex* FindIndex(FName Name)
+	{
+		return Indices.FindByPredicate([Name](const FIndex& Index)
+		{
+			return Index.Name == Name;
+		});
+	}
+
+	const FIndex* FindIndex(FName Name) const
+	{
+		return Indices.FindByPredicate([Name](const FIndex& Index)
+		{
+			return Index.Name == Name;
+		});
+	}
+
+	bool Passes(const FIndex& Index, int32 Slot) const
+	{
+		return !Index.Filter || Index.Filter(Entries[Slot].Entry);
+	}
+
+	void InsertIntoIndex(FIndex& Index, int32 Slot)
+	{
+		Index.Tree.Insert(Slot, [this, &Index](int32 A, int32 B)
+		{
+			const auto& SlotA = Entries[A];
+			const auto& SlotB = Entries[B];
+			if(Index.Less(SlotA.Entry, SlotB.Entry)) return true;
+			if(Index.Less(SlotB.Entry, SlotA.Entry)) return false;
+			//Equal entries are ordered by key, so the order is total and stable across rebuilds
+			return SlotA.Key < SlotB.Key;
+		});
+	}
+
+	void RebuildIndex(FIndex& Index)
+	{
+		Index.Tree.Reset();
+		for (auto It = Entries.CreateConstIterator(); It; ++It)
+		{
+			if(Passes(Index, It.GetIndex()))
+			{
+				InsertIntoIndex(Index, It.GetIndex());
+			}
+		}
+	}
+
+	void UpdateSlot(int32 Slot, TFunctionRef<void(TEntry& Entry)> Mutator)
+	{
+		//The comparators read the entry, so it leaves every index before it changes
+		TArray<int32, TInlineAllocator<8>> OldPositions;
+		for (auto& Index : Indices)
+		{
+			const int32 Position = Index.Tree.IndexOf(Slot);
+			OldPositions.Add(Position);
+			if(Position != INDEX_NONE)
+			{
+				Index.Tree.Remove(Slot);
+			}
+		}
+
+		Mutator(Entries[Slot].Entry);
+
+		for (int32 IndexId = 0; IndexId < Indices.Num(); ++IndexId)
+		{
+			auto& Index = Indices[IndexId];
+			int32 NewPosition = INDEX_NONE;
+			if(Passes(Index, Slot))
+			{
+				InsertIntoIndex(Index, Slot);
+				NewPosition = Index.Tree.IndexOf(Slot);
+			}
+
+			if(OldPositions[IndexId] != INDEX_NONE || NewPosition != INDEX_NONE)
+			{
+				Broadcast(Index, Entries[Slot].Key, OldPositions[IndexId], NewPosition);
+			}
+		}
+	}
+
+	void Broadcast(const FIndex& Index, int64 Key, int32 OldPosition, int32 NewPosition)
+	{
+		if(OnIndexChanged.IsBound())
+		{
+			TGuardValue<bool> BroadcastGuard(bIsBroadcasting, true);
+			OnIndexChanged.Broadcast(Index.Name, Key, OldPosition, NewPosition);
+		}
+	}
+
+	void CheckNotBroadcasting() const
+	{
+		//A change from a listener would reallocate Indices or move entries while they are being iterated
+		checkf(!bIsBroadcasting, TEXT("TModelCollection can not be changed from an OnIndexChanged listener"));
+	}
+
+	TSparseArray<FSlot> Entries;
+	TMap<int64, int32> Slots;
+	TArray<FIndex> Indices;
+	bool bIsBroadcasting = false;
+};
@@ -0,0 +1,164 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "ModelMutationRecorderSubsystem.generated.h"
+
+class FArchive;
+class UObjectWithWorldContext;
+
+/**
+ * Kind of the model a recorded mutation belongs to.
+ */
+UENUM()
+enum class ERecordedModelKind : uint8
+{
+	Session,
+	Contextual,
+};
+
+/**
+ * How a recorded stream advances during replay.
+ */
+UENUM(BlueprintType)
+enum class EModelReplayMode : uint8
+{
+	/** Every replay frame applies the changes of PlaybackRate recorded frames. Independent of frame timing, so runs are comparable */
+	RecordedFrames,
+	/** Recorded timestamps against the replay time advanced by DeltaTime * PlaybackRate */
+	RecordedTime,
+};
+
+/**
+ * One decoded field change of a recorded stream.
+ */
+USTRUCT()
+struct FRecordedModelMutation
+{
+	GENERATED_BODY()
+
+	/** Seconds since the start of the recording */
+	float Time = 0.f;
+
+	/** Frames since the start of the recording */
+	uint32 Frame = 0;
+
+	ERecordedModelKind ModelKind = ERecordedModelKind::Session;
+
+	UPROPERTY()
+	TObjectPtr<UClass> ModelClass = nullptr;
+
+	/** Key of an entity contextual model. 0 for session models and the single contextual model of a class */
+	uint64 EntityKey = 0;
+
+	/** Index of the recorded actor path of an actor model, INDEX_NONE for other models. Replaces EntityKey on replay */
+	int32 ActorIndex = INDEX_NONE;
+
+	FName FieldName = NAME_None;
+
+	/** Binary serialized value of the field */
+	TArray<uint8> Payload;
+};
+
+/**
+ * Records the timestamped stream of observable field changes of session and contextual models into a compact binary file,
+ * and replays it into the same models, so views and viewmodels can be profiled with real gameplay data.
+ * Only changes reported through NotifyFieldChanged are captured.
+ */
+UCLASS(NotBlueprintable, BlueprintType)
+class MVVMLIBRARY_API UModelMutationRecorderSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+private:
+
+	UPROPERTY()
+	TArray<FRecordedModelMutation> ReplayMutations;
+	/** Paths of the recorded actors relative to their world, indexed by FRecordedModelMutation::ActorIndex */
+	TArray<FString> ReplayActorPaths;
+
+	int32 NextReplayMutation = 0;
+	float ReplayTime = 0.f;
+	double ReplayFrame = 0.0;
+	float ReplayRate = 1.f;
+	EModelReplayMode ReplayMode = EModelReplayMode::RecordedFrames;
+	int32 SkippedReplayMutations = 0;
+	int32 SkippedActorMutations = 0;
+	bool bIsReplaying = false;
+
+	double ReplayApplySeconds = 0.0;
+	double ReplayWallStartTime = 0.0;
+	TMap<UClass*, double> ReplayApplySecondsPerClass;
+
+	TUniquePtr<FArchive> RecordWriter;
+	double RecordStartTime = 0.0;
+	uint64 RecordStartFrame = 0;
+	TMap<UClass*, uint16> RecordedClassIds;
+	TMap<FName, uint16> RecordedFieldIds;
+	/** Actor entity key to the id of its declared path */
+	TMap<uint64, uint16> RecordedActorIds;
+
+	/** Number of recorders currently recording. Lets models skip the recorder lookup when nothing records */
+	static int32 ActiveRecordings;
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * Starts capturing model field changes into a file. Relative paths are resolved against the Profiling directory.
+	 * @param FilePath Destination file
+	 * @return Is Successful?
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MVVM|MutationRecorder")
+	bool StartRecording(const FString& FilePath);
+	UFUNCTION(BlueprintCallable, Category = "MVVM|MutationRecorder")
+	void StopRecording();
+	UFUNCTION(BlueprintCallable, Category = "MVVM|MutationRecorder")
+	bool IsRecording() const;
+
+	/**
+	 * Feeds a recorded stream back into the models that exist. Changes of models that do not exist are skipped, the replay
+	 * never creates models. Update cost of every applied change is measured and a per-model-class breakdown is logged when the replay ends.
+	 * @param FilePath Recorded file. Relative paths are resolved against the Profiling directory
+	 * @param PlaybackRate 1 == recorded speed, greater values accelerate the replay
+	 * @param Mode RecordedFrames applies the same changes in the same replay frames on every run
+	 * @return Is Successful?
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MVVM|MutationRecorder")
+	bool StartReplay(const FString& FilePath, float PlaybackRate = 1.f, EModelReplayMode Mode = EModelReplayMode::RecordedFrames);
+	UFUNCTION(BlueprintCallable, Category = "MVVM|MutationRecorder")
+	void StopReplay();
+	UFUNCTION(BlueprintCallable, Category = "MVVM|MutationRecorder")
+	bool IsReplaying() const;
+
+	/**
+	 * Service method. Called by models from NotifyFieldChanged.
+	 * @param Model Session or contextual model
+	 * @param FieldName Changed field
+	 */
+	static void RecordFieldChange(const UObjectWithWorldContext* Model, FName FieldName);
+
+	//FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	void WriteFieldChange(const UObjectWithWorldContext* Model, ERecordedModelKind ModelKind, FName FieldName);
+	bool LoadRecording(const FString& FilePath);
+	/** @return Was the target model found? The replay never creates models */
+	bool ApplyMutation(const FRecordedModelMutation& Mutation);
+	void LogReplayReport() const;
+
+	static FString ResolveRecordingPath(const FString& FilePath);
+};
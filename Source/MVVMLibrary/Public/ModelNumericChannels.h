@@ -0,0 +1,107 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Structure-of-arrays store of numeric model state for many entities, e.g. health, cooldowns and distances of hundreds
+ * of tracked units. Every channel is one contiguous float buffer indexed by a dense entity id. Values are written freely
+ * during the frame; DetectChanges then compares every channel with the values last reported to views, four entities per
+ * SIMD instruction, and fills one dirty bitset per channel. Views read the bitsets instead of receiving one broadcast
+ * per changed value. The bitsets stay unchanged until the next DetectChanges.
+ * Declare it as a member of a model and call DetectChanges once per frame. Game thread only.
+ */
+class MVVMLIBRARY_API FModelNumericChannels
+{
+public:
+
+	/**
+	 * @param Name Id of the channel
+	 * @param Tolerance Changes up to this absolute difference are not reported. They accumulate until they exceed it.
+	 *                  Becoming NaN or stopping being NaN is always reported
+	 * @return Channel index
+	 */
+	int32 AddChannel(FName Name, float Tolerance = 0.f);
+
+	/** @return Channel index or INDEX_NONE */
+	int32 FindChannel(FName Name) const;
+	int32 NumChannels() const;
+
+	/**
+	 * Resizes every channel. New entities start at 0 and are reported dirty by the next DetectChanges
+	 */
+	void SetNumEntities(int32 Num);
+	int32 NumEntities() const;
+
+	void SetValue(int32 Channel, int32 Entity, float Value);
+	float GetValue(int32 Channel, int32 Entity) const;
+
+	/** @return Values of a channel for bulk writes, one per entity */
+	TArrayView<float> GetValues(int32 Channel);
+	TConstArrayView<float> GetValues(int32 Channel) const;
+
+	/** Reports the entity dirty in every channel on the next DetectChanges, e.g. when its id is reused */
+	void MarkEntityDirty(int32 Entity);
+
+	/**
+	 * Builds the dirty bitsets of all channels in one pass and commits the reported values.
+	 * @return Number of entities changed in any channel
+	 */
+	int32 DetectChanges();
+
+	/**
+	 * @param Channel Channel index. INDEX_NONE == any channel
+	 */
+	bool IsDirty(int32 Channel, int32 Entity) const;
+
+	/**
+	 * Visits the entities changed in the last DetectChanges in ascending order.
+	 * @param Channel Channel index. INDEX_NONE == any channel
+	 */
+	void ForEachDirtyEntity(int32 Channel, TFunctionRef<void(int32 Entity)> Callback) const;
+
+	/**
+	 * @param Channel Channel index. INDEX_NONE == any channel
+	 * @return Dirty bitset, bit Entity % 32 of word Entity / 32
+	 */
+	TConstArrayView<uint32> GetDirtyBits(int32 Channel) const;
+
+	/** @return Number of DetectChanges calls that found changes. Lets views skip frames without changes */
+	uint32 GetChangeSerial() const;
+
+private:
+
+	/** Entities per dirty word. A word covers 8 SIMD groups of 4 */
+	static constexpr int32 EntitiesPerWord = 32;
+
+	struct FChannel
+	{
+		FName Name;
+		float Tolerance = 0.f;
+
+		/** Written during the frame. Padded to whole dirty words with zeros */
+		TArray<float, TAlignedHeapAllocator<16>> Values;
+
+		/** Values last reported dirty */
+		TArray<float, TAlignedHeapAllocator<16>> ReportedValues;
+
+		TArray<uint32> DirtyBits;
+	};
+
+	int32 NumPaddedEntities() const;
+
+	TArray<FChannel> Channels;
+	int32 EntityCount = 0;
+
+	/** Union of the dirty bits of all channels */
+	TArray<uint32> AnyDirtyBits;
+
+	/** Entities reported dirty by the next DetectChanges regardless of their values */
+	TArray<uint32> ForcedDirtyBits;
+
+	uint32 ChangeSerial = 0;
+};
@@ -7,6 +7,7 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "LightModelStorage.h"
 #include "ModelRepositorySubsystem.generated.h"
 
 class UUISessionModel;
@@ -24,6 +25,17 @@ private:
 	UPROPERTY()
 	TMap<UClass*, UUISessionModel*> SessionModels;
 
+	/** Plain-struct models in dense per-type storage. Not scanned by GC */
+	FLightModelStorage LightModels;
+
+	/** Models with EndOfFrame snapshots changed in this frame */
+	TArray<TWeakObjectPtr<UUISessionModel>> DirtySnapshotModels;
+
+	/** DirtySnapshotModels being published. Kept as a member to reuse its allocation */
+	TArray<TWeakObjectPtr<UUISessionModel>> PublishingSnapshotModels;
+
+	FDelegateHandle EndFrameHandle;
+
 protected:
 	/**
 	 * Blueprint variant GetSessionModel. 
@@ -34,6 +46,10 @@ protected:
 	void K2_GetSessionModel(UUISessionModel*& OutSessionModel, UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUISessionModel> ModelType);
 
 public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
 	/**
 	 * C++ variant GetSessionModel. 
 	 * @param ModelType Selected model type
@@ -55,14 +71,35 @@ public:
 		return Cast<T>(GetSessionModel(T::StaticClass()));
 	}
 
+	/**
+	 * Gives a session model without creating it.
+	 * @return Model or nullptr
+	 */
+	UUISessionModel* FindSessionModel(TSubclassOf<UUISessionModel> ModelType) const;
+
 	/**
 	 * Calls the native End Session event on all session models. Should only be called in a Game instance on Shutdown event.
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|ModelRepository")
 	void CloseSession();
 
+	/**
+	 * Light models of this repository. See FLightModelStorage
+	 */
+	FLightModelStorage& GetLightModels()
+	{
+		return LightModels;
+	}
+
 private:
 	
 	UFUNCTION()
 	UUISessionModel* CreateSessionModel(const TSubclassOf<UUISessionModel>& ModelType);
+
+	/** Queues PublishSnapshot of a model for the end of the frame */
+	void MarkSnapshotDirty(UUISessionModel* Model);
+
+	void PublishDirtySnapshots();
+
+	friend class UUISessionModel;
 };
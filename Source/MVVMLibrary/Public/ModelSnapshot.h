@@ -0,0 +1,136 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+/**
+ * Immutable, reference-counted copy of model state readable from any thread. The game thread publishes a new copy
+ * while readers keep the copy they took, so a reader always sees a consistent state and never blocks the live model.
+ * Readers only lock for the copy of the pointer, never while reading the state.
+ * Publish from the game thread, read with Get or through a Reader from any thread.
+ * @tparam T State of the model
+ */
+template<typename T>
+class TModelSnapshot
+{
+public:
+
+	using FSnapshotPtr = TSharedPtr<const T, ESPMode::ThreadSafe>;
+
+private:
+
+	struct FSlot
+	{
+		mutable FRWLock Lock;
+		FSnapshotPtr Value;
+		std::atomic<uint32> Version = 0;
+	};
+
+	using FSlotPtr = TSharedPtr<FSlot, ESPMode::ThreadSafe>;
+
+public:
+
+	/**
+	 * Handle to the published snapshots of a model. Take it on the game thread and pass it to a worker:
+	 * it stays valid after the model is destroyed and then gives the last published snapshot.
+	 */
+	class FReader
+	{
+	public:
+
+		FReader() = default;
+
+		/** @return Last published snapshot or nullptr. Any thread */
+		FSnapshotPtr Get() const
+		{
+			if(!Slot.IsValid()) return nullptr;
+
+			FReadScopeLock ScopeLock(Slot->Lock);
+			return Slot->Value;
+		}
+
+		/** @return Number of published snapshots. Any thread */
+		uint32 GetVersion() const
+		{
+			return Slot.IsValid() ? Slot->Version.load(std::memory_order_acquire) : 0;
+		}
+
+		bool IsValid() const
+		{
+			return Slot.IsValid();
+		}
+
+	private:
+
+		explicit FReader(const FSlotPtr& InSlot)
+			: Slot(InSlot)
+		{
+		}
+
+		FSlotPtr Slot;
+
+		friend class TModelSnapshot;
+	};
+
+	TModelSnapshot()
+		: Slot(MakeShared<FSlot, ESPMode::ThreadSafe>())
+	{
+	}
+
+	UE_NONCOPYABLE(TModelSnapshot);
+
+	/**
+	 * Replaces the published snapshot. Readers holding the previous one keep it until they release it.
+	 * @param NewValue Snapshot that must not be changed afterwards
+	 */
+	void Publish(FSnapshotPtr NewValue)
+	{
+		check(IsInGameThread());
+
+		{
+			FWriteScopeLock ScopeLock(Slot->Lock);
+			Swap(Slot->Value, NewValue);
+			Slot->Version.fetch_add(1, std::memory_order_release);
+		}
+		//The previous snapshot is released outside the lock, its destructor may be expensive
+	}
+
+	/** Publishes a copy of the live state */
+	void Publish(const T& Value)
+	{
+		Publish(MakeShared<const T, ESPMode::ThreadSafe>(Value));
+	}
+
+	void Publish(T&& Value)
+	{
+		Publish(MakeShared<const T, ESPMode::ThreadSafe>(MoveTemp(Value)));
+	}
+
+	/** @return Last published snapshot or nullptr. Any thread */
+	FSnapshotPtr Get() const
+	{
+		FReadScopeLock ScopeLock(Slot->Lock);
+		return Slot->Value;
+	}
+
+	/** @return Number of published snapshots. Any thread */
+	uint32 GetVersion() const
+	{
+		return Slot->Version.load(std::memory_order_acquire);
+	}
+
+	/** @return Handle readable from worker threads after this model is destroyed */
+	FReader GetReader() const
+	{
+		return FReader(Slot);
+	}
+
+private:
+
+	FSlotPtr Slot;
+};
@@ -30,4 +30,13 @@ public:
 	UWorld* GetWorldContext() const;
 
 	virtual UWorld* GetWorld() const override;
+
+protected:
+
+	/**
+	 * Binds the world context once at creation, so GetWorld never has to walk the outer chain.
+	 * The binding is weak and is dropped automatically when the world is torn down.
+	 * @param InWorld World the object lives in
+	 */
+	void BindWorldContext(UWorld* InWorld);
 };
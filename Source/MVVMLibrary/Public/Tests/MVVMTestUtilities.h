@@ -0,0 +1,178 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/MemoryBase.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+/**
+ * Counts the heap allocations made by the calling thread while it is in scope. Installs itself as GMalloc and forwards
+ * every call to the allocator it replaced, so blocks allocated before or after the scope are freed normally.
+ * Automation tests only.
+ */
+class FMVVMScopedAllocationCounter final : public FMalloc
+{
+public:
+
+	FMVVMScopedAllocationCounter()
+		: InnerMalloc(GMalloc)
+		, ThreadId(FPlatformTLS::GetCurrentThreadId())
+	{
+		GMalloc = this;
+	}
+
+	virtual ~FMVVMScopedAllocationCounter() override
+	{
+		GMalloc = InnerMalloc;
+	}
+
+	UE_NONCOPYABLE(FMVVMScopedAllocationCounter);
+
+	/** @return Allocations and reallocations of the calling thread so far */
+	int32 GetNumAllocations() const
+	{
+		return NumAllocations.load(std::memory_order_relaxed);
+	}
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation(1);
+		return InnerMalloc->Malloc(Count, Alignment);
+	}
+
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation(1);
+		return InnerMalloc->TryMalloc(Count, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		//Realloc to 0 is a free
+		CountAllocation(Count > 0 ? 1 : 0);
+		return InnerMalloc->Realloc(Original, Count, Alignment);
+	}
+
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation(Count > 0 ? 1 : 0);
+		return InnerMalloc->TryRealloc(Original, Count, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		InnerMalloc->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return InnerMalloc->QuantizeSize(Count, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return InnerMalloc->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		InnerMalloc->Trim(bTrimThreadCaches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return InnerMalloc->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return InnerMalloc->ValidateHeap();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return InnerMalloc->GetDescriptiveName();
+	}
+
+private:
+
+	void CountAllocation(int32 Num)
+	{
+		//Other threads keep allocating while a test runs, only the measured code is counted
+		if(Num > 0 && FPlatformTLS::GetCurrentThreadId() == ThreadId)
+		{
+			NumAllocations.fetch_add(Num, std::memory_order_relaxed);
+		}
+	}
+
+	FMalloc* const InnerMalloc;
+	const uint32 ThreadId;
+	std::atomic<int32> NumAllocations = 0;
+};
+
+/**
+ * Standalone game instance with a Game world, so game instance and world subsystems are created as in a running game.
+ * Shut down and destroyed with the scope. Automation tests only.
+ */
+class FMVVMTestWorld
+{
+public:
+
+	FMVVMTestWorld()
+	{
+		GameInstance = NewObject<UGameInstance>(GEngine);
+		GameInstance->AddToRoot();
+		GameInstance->InitializeStandalone();
+	}
+
+	~FMVVMTestWorld()
+	{
+		UWorld* World = GetWorld();
+
+		GameInstance->Shutdown();
+		GameInstance->RemoveFromRoot();
+
+		if(World)
+		{
+			World->DestroyWorld(false);
+			GEngine->DestroyWorldContext(World);
+		}
+	}
+
+	UE_NONCOPYABLE(FMVVMTestWorld);
+
+	UWorld* GetWorld() const
+	{
+		return GameInstance->GetWorld();
+	}
+
+	UGameInstance* GetGameInstance() const
+	{
+		return GameInstance;
+	}
+
+private:
+
+	UGameInstance* GameInstance = nullptr;
+};
+
+#endif
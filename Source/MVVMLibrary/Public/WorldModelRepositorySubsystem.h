@@ -7,11 +7,43 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "LightModelStorage.h"
 #include "WorldModelRepositorySubsystem.generated.h"
 
+class AActor;
 class UModelRepositorySubsystem;
 class UUIContextualModel;
 
+/**
+ * Keyed contextual models of one class. Models are dense in creation order, destruction moves the last model into the hole.
+ */
+USTRUCT()
+struct FEntityModelBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UUIContextualModel>> Models;
+
+	/** Key of Models[Index] */
+	TArray<uint64> Keys;
+	TMap<uint64, int32> KeyToIndex;
+};
+
+/**
+ * Users and last access of a contextual model. An evictable model without live users is idle.
+ */
+struct FContextualModelUsage
+{
+	TArray<TWeakObjectPtr<const UObject>> Users;
+
+	double LastAccessTime = 0.0;
+
+	/** GetEstimatedMemorySize of the model while idle. INDEX_NONE until measured, reset on access */
+	int64 EstimatedMemorySize = INDEX_NONE;
+
+	bool HasLiveUsers() const;
+};
 
 /**
  * This class is used to store contextual models, i.e. models that live during one scene.
@@ -26,9 +58,21 @@ private:
 	UPROPERTY()
 	TMap<UClass*, UUIContextualModel*> ContextualModels;
 
+	/** Per-entity contextual models by class */
+	UPROPERTY()
+	TMap<UClass*, FEntityModelBucket> EntityModels;
+
+	/** Plain-struct models in dense per-type storage. Not scanned by GC */
+	FLightModelStorage LightModels;
+
 	UPROPERTY()
 	mutable TWeakObjectPtr<UModelRepositorySubsystem> ModelRepositorySubsystemCache = nullptr;
 
+	/** Keyed like ContextualModels. Only evictable models are tracked */
+	TMap<UClass*, FContextualModelUsage> ModelUsages;
+
+	FTimerHandle EvictionTimerHandle;
+
 protected:
 	/**
 	 * Blueprint variant of GetContextualModel method
@@ -38,9 +82,33 @@ protected:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, DisplayName = "GetContextualModel", Category = "MVVM|WorldModelRepository", meta=(DeterminesOutputType = "ModelType", DynamicOutputParam = "OutContextualModel"))
 	void K2_GetContextualModel(UUIContextualModel*& OutContextualModel, UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIContextualModel> ModelType);
 
+	/**
+	 * Blueprint variant of GetEntityModel method
+	 * @param ModelType Selected type
+	 * @param Key Id of the entity
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, DisplayName = "GetEntityModel", Category = "MVVM|WorldModelRepository", meta=(DeterminesOutputType = "ModelType"))
+	UUIContextualModel* K2_GetEntityModel(UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIContextualModel> ModelType, int64 Key);
+
+	/**
+	 * Blueprint variant of DestroyEntityModel method
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, DisplayName = "DestroyEntityModel", Category = "MVVM|WorldModelRepository")
+	bool K2_DestroyEntityModel(TSubclassOf<UUIContextualModel> ModelType, int64 Key);
+
+	/**
+	 * Blueprint variant of GetEntityModels method
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, DisplayName = "GetEntityModels", Category = "MVVM|WorldModelRepository", meta=(DeterminesOutputType = "ModelType", DynamicOutputParam = "OutModels"))
+	void K2_GetEntityModels(TSubclassOf<UUIContextualModel> ModelType, TArray<UUIContextualModel*>& OutModels);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
 public:
-	
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 
 	/**
 	 * C++ variant of GetContextualModel method.
@@ -63,6 +131,110 @@ public:
 		return Cast<T>(GetContextualModel(T::StaticClass()));
 	}
 
+	/**
+	 * Gives the single contextual model of a class without creating it. Does not count as an access for eviction.
+	 * @return Model or nullptr
+	 */
+	UUIContextualModel* FindContextualModel(TSubclassOf<UUIContextualModel> ModelType) const;
+
+	/**
+	 * Gives the contextual model of one entity, creating it when missing. Any number of entities can have a model of the same class.
+	 * @param ModelType Selected type
+	 * @param Key Id of the entity. A class should be keyed either by ids or by actors, not both
+	 * @return Model
+	 */
+	UUIContextualModel* GetEntityModel(TSubclassOf<UUIContextualModel> ModelType, uint64 Key);
+
+	template<class T>
+	T* GetEntityModel(uint64 Key)
+	{
+		static_assert(TIsDerivedFrom<T, UUIContextualModel>::IsDerived, "GetEntityModel can only be used to create UUIContextualModel instances");
+
+		return Cast<T>(GetEntityModel(T::StaticClass(), Key));
+	}
+
+	/**
+	 * Gives the contextual model of an actor, creating it when missing.
+	 * The model is destroyed automatically when the actor ends play, e.g. when it is destroyed or streamed out.
+	 * @param ModelType Selected type
+	 * @param Actor Entity
+	 * @return Model
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WorldModelRepository", meta=(DeterminesOutputType = "ModelType"))
+	UUIContextualModel* GetActorModel(UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIContextualModel> ModelType, AActor* Actor);
+
+	template<class T>
+	T* GetActorModel(AActor* Actor)
+	{
+		static_assert(TIsDerivedFrom<T, UUIContextualModel>::IsDerived, "GetActorModel can only be used to create UUIContextualModel instances");
+
+		return Cast<T>(GetActorModel(T::StaticClass(), Actor));
+	}
+
+	/**
+	 * Gives the contextual model of one entity without creating it.
+	 * @return Model or nullptr
+	 */
+	UUIContextualModel* FindEntityModel(TSubclassOf<UUIContextualModel> ModelType, uint64 Key) const;
+
+	/**
+	 * Calls OnDestroyModel and removes the model of one entity.
+	 * @return Was the model stored?
+	 */
+	bool DestroyEntityModel(TSubclassOf<UUIContextualModel> ModelType, uint64 Key);
+
+	/**
+	 * Gives all entity models of a class, dense in one array. The view is invalidated by creation and destruction of models of the class.
+	 * @param ModelType Selected type
+	 * @return Models
+	 */
+	TConstArrayView<TObjectPtr<UUIContextualModel>> GetEntityModels(TSubclassOf<UUIContextualModel> ModelType) const;
+
+	/**
+	 * Key of an actor for entity models. Never reused by another actor.
+	 */
+	static uint64 MakeEntityKey(const AActor* Actor);
+
+	/**
+	 * Marks a contextual model as used, so it is never evicted while the user is alive.
+	 * References are weak: a destroyed user releases its references by itself.
+	 * @param ModelType Type of the model
+	 * @param User View, viewmodel or any other object that reads the model
+	 * @return Model, created if needed
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WorldModelRepository", meta=(DeterminesOutputType = "ModelType", DefaultToSelf = "User"))
+	UUIContextualModel* AddModelReference(UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIContextualModel> ModelType, const UObject* User);
+
+	/**
+	 * Releases a reference added by AddModelReference.
+	 * @param ModelType Type of the model
+	 * @param User User that added the reference
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WorldModelRepository", meta=(DefaultToSelf = "User"))
+	void RemoveModelReference(TSubclassOf<UUIContextualModel> ModelType, const UObject* User);
+
+	/**
+	 * Releases all references of a user.
+	 * @param User User that added the references
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WorldModelRepository", meta=(DefaultToSelf = "User"))
+	void RemoveAllModelReferences(const UObject* User);
+
+	/**
+	 * Evicts idle evictable models above the memory budget or over the idle timeout of the plugin settings.
+	 * Called every ContextualModelEvictionInterval seconds.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WorldModelRepository")
+	void EvictIdleModels();
+
+	/**
+	 * Light models of this repository. See FLightModelStorage
+	 */
+	FLightModelStorage& GetLightModels()
+	{
+		return LightModels;
+	}
+
 private:
 
 	UFUNCTION()
@@ -70,4 +242,16 @@ private:
 	
 	UFUNCTION()
 	UUIContextualModel* CreateContextualModel(const TSubclassOf<UUIContextualModel>& ModelType);
+
+	void EvictModel(UClass* ModelType);
+
+	/**
+	 * Creates a model and binds its services. OnInitModel is left to the caller
+	 */
+	UUIContextualModel* NewContextualModel(UClass* ModelType, uint64 EntityKey = 0, AActor* EntityActor = nullptr);
+
+	UUIContextualModel* CreateEntityModel(UClass* ModelType, uint64 Key, AActor* Actor);
+
+	UFUNCTION()
+	void OnEntityActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
 };
@@ -0,0 +1,169 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "Abstract/UIPopUpView.h"
+#include "BlueprintEventMask.h"
+#include "ModelRepositorySubsystem.h"
+#include "WorldModelRepositorySubsystem.h"
+#include "WindowSubsystem.h"
+#include "MVVMHitchTracker.h"
+
+namespace UIPopUpViewEvents
+{
+	/** Index of the event in the name table of IsImplementedInBlueprint, which is also its bit in the mask */
+	enum EEvent : uint32
+	{
+		InitializePopUp,
+		InitializeNotification,
+		OnNotificationCoalesced,
+		Num
+	};
+}
+
+void UUIPopUpView::NativeDestruct()
+{
+	MVVM_HITCH_SCOPE(Teardown, GetClass());
+	
+	bIsDestroyedPopUp = true;
+	OnDestroyPopUp.Broadcast();
+
+	if(LifeSpanHandle.IsValid())
+	{
+		if(const auto WindowSubsystem = GetWindowSubsystem())
+		{
+			WindowSubsystem->CancelPopUpLifeSpan(LifeSpanHandle);
+		}
+		LifeSpanHandle.Invalidate();
+	}
+
+	if(const auto Subsystem = NotificationSubsystem.Get())
+	{
+		NotificationSubsystem.Reset();
+		Subsystem->OnNotificationDestroyed(this);
+	}
+	
+	Super::NativeDestruct();
+}
+
+void UUIPopUpView::InitializePopUp(UModelRepositorySubsystem* InModelRepository,
+	UWorldModelRepositorySubsystem* InWorldModelRepository)
+{
+	if(bIsInitializedPopUp) return;
+
+	MVVM_HITCH_SCOPE(ViewInitialization, GetClass());
+
+	bIsInitializedPopUp = true;
+
+	ModelRepository = InModelRepository;
+	WorldModelRepository = InWorldModelRepository;
+
+	if(IsImplementedInBlueprint(UIPopUpViewEvents::InitializePopUp))
+	{
+		K2_InitializePopUp(InModelRepository, InWorldModelRepository);
+	}
+	
+	StartSelfDestroyTimer();
+}
+
+void UUIPopUpView::InitializeNotification(FName Key, int32 Count, UObject* Payload)
+{
+	if(IsImplementedInBlueprint(UIPopUpViewEvents::InitializeNotification))
+	{
+		K2_InitializeNotification(Key, Count, Payload);
+	}
+}
+
+void UUIPopUpView::OnNotificationCoalesced(int32 Count, UObject* Payload)
+{
+	StartSelfDestroyTimer();
+
+	if(IsImplementedInBlueprint(UIPopUpViewEvents::OnNotificationCoalesced))
+	{
+		K2_OnNotificationCoalesced(Count, Payload);
+	}
+}
+
+void UUIPopUpView::StartSelfDestroyTimer()
+{
+	if(!bUseSelfDestroyTimer) return;
+
+	if(const auto WindowSubsystem = GetWindowSubsystem())
+	{
+		WindowSubsystem->SchedulePopUpLifeSpan(this, LifeSpan);
+	}
+}
+
+void UUIPopUpView::ExtendLifeSpan(float Seconds)
+{
+	if(const auto WindowSubsystem = GetWindowSubsystem())
+	{
+		WindowSubsystem->SchedulePopUpLifeSpan(this, WindowSubsystem->GetPopUpRemainingLifeSpan(LifeSpanHandle) + Seconds);
+	}
+}
+
+float UUIPopUpView::GetRemainingLifeSpan() const
+{
+	const auto WindowSubsystem = GetWindowSubsystem();
+	return WindowSubsystem ? WindowSubsystem->GetPopUpRemainingLifeSpan(LifeSpanHandle) : 0.f;
+}
+
+void UUIPopUpView::DismissPopUp()
+{
+	RemoveFromParent();
+}
+
+EUILayer UUIPopUpView::GetUILayer() const
+{
+	return ViewLayer;
+}
+
+bool UUIPopUpView::IsInitializedPopUp() const
+{
+	return bIsInitializedPopUp;
+}
+
+bool UUIPopUpView::IsPopUpDestroyed() const
+{
+	return bIsDestroyedPopUp;
+}
+
+int32 UUIPopUpView::GetNotificationCount() const
+{
+	return NotificationCount;
+}
+
+UModelRepositorySubsystem* UUIPopUpView::GetModelRepository() const
+{
+	return ModelRepository.IsValid() ? ModelRepository.Get() : nullptr;
+}
+
+UWorldModelRepositorySubsystem* UUIPopUpView::GetWorldModelRepository() const
+{
+	return WorldModelRepository.IsValid() ? WorldModelRepository.Get() : nullptr;
+}
+
+void UUIPopUpView::OnDestroyTimerComplete()
+{
+	RemoveFromParent();
+}
+
+UWindowSubsystem* UUIPopUpView::GetWindowSubsystem() const
+{
+	return UWorld::GetSubsystem<UWindowSubsystem>(GetWorld());
+}
+
+bool UUIPopUpView::IsImplementedInBlueprint(uint32 Event)
+{
+	static const FName EventNames[] =
+	{
+		GET_FUNCTION_NAME_CHECKED(UUIPopUpView, K2_InitializePopUp),
+		GET_FUNCTION_NAME_CHECKED(UUIPopUpView, K2_InitializeNotification),
+		GET_FUNCTION_NAME_CHECKED(UUIPopUpView, K2_OnNotificationCoalesced),
+	};
+	static_assert(UE_ARRAY_COUNT(EventNames) == UIPopUpViewEvents::Num, "Every event needs a name, in EEvent order");
+
+	return FBlueprintEventMask::IsImplemented(ImplementedBlueprintEvents, GetClass(), EventNames, Event);
+}
@@ -0,0 +1,361 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "Abstract/UIView.h"
+
+#include "Abstract/UIViewModel.h"
+#include "ModelRepositorySubsystem.h"
+#include "WorldModelRepositorySubsystem.h"
+#include "WindowSubsystem.h"
+#include "MVVMLibraryUISettings.h"
+#include "MVVMHitchTracker.h"
+#include "Engine/World.h"
+#include "Serialization/MemoryReader.h"
+#include "Widgets/SInvalidationPanel.h"
+
+
+TSharedRef<SWidget> UUIView::RebuildWidget()
+{
+	const TSharedRef<SWidget> Content = Super::RebuildWidget();
+
+	switch (Volatility)
+	{
+	case EUIViewVolatility::Cached:
+		return SAssignNew(InvalidationPanel, SInvalidationPanel)
+			[
+				Content
+			];
+	case EUIViewVolatility::Volatile:
+		Content->ForceVolatile(true);
+		return Content;
+	default:
+		return Content;
+	}
+}
+
+void UUIView::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	InvalidationPanel.Reset();
+}
+
+void UUIView::NativeDestruct()
+{
+	MVVM_HITCH_SCOPE(Teardown, GetClass());
+	
+	OnDestroyView.Broadcast();
+
+	if(BoundActor.IsValid())
+	{
+		BindToActor(nullptr);
+	}
+
+	//A viewmodel class still streaming in must not create a viewmodel for a destroyed view, see OnViewModelClassLoaded
+	PendingModelRepository.Reset();
+	PendingWorldModelRepository.Reset();
+	PendingWindowSubsystem.Reset();
+	PendingViewModelData.Reset();
+	PendingRestoreState.Empty();
+
+	if(ViewModel)
+	{
+		ViewModel->DetachView(this);
+
+		//A pooled viewmodel is handed to the next view, this one must not reach it anymore
+		if(ViewModel->bIsPoolable && !ViewModel->bIsShared)
+		{
+			ViewModel = nullptr;
+		}
+	}
+	
+	Super::NativeDestruct();
+}
+
+void UUIView::InitializeView(UModelRepositorySubsystem* InModelRepository,
+                             UWorldModelRepositorySubsystem* InWorldModelRepository, UWindowSubsystem* InWindowSubsystem)
+{
+	if(bIsInitializedView) return;
+
+	MVVM_HITCH_SCOPE(ViewInitialization, GetClass());
+
+	bIsInitializedView = true;
+	checkf(!ViewModelClass.IsNull(), TEXT("You have not selected a viewmodel class in view settings. View class name: %s"), *GetNameSafe(this));
+
+	if(UClass* LoadedViewModelClass = ViewModelClass.Get())
+	{
+		CreateViewModel(LoadedViewModelClass, InModelRepository, InWorldModelRepository, InWindowSubsystem);
+		return;
+	}
+
+	//The class is not preloaded: stream it in instead of blocking the frame with a synchronous load
+	PendingModelRepository = InModelRepository;
+	PendingWorldModelRepository = InWorldModelRepository;
+	PendingWindowSubsystem = InWindowSubsystem;
+	ViewModelClass.ToSoftObjectPath().LoadAsync(FLoadSoftObjectPathAsyncDelegate::CreateWeakLambda(this, [this](const FSoftObjectPath&, UObject* LoadedClass)
+	{
+		OnViewModelClassLoaded(LoadedClass);
+	}));
+}
+
+void UUIView::CollectPreloadAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	if(!ViewModelClass.IsNull())
+	{
+		OutAssets.Add(ViewModelClass.ToSoftObjectPath());
+	}
+}
+
+EUILayer UUIView::GetUILayer() const
+{
+	return ViewLayer;
+}
+
+bool UUIView::IsInitializedView() const
+{
+	return bIsInitializedView;
+}
+
+bool UUIView::IsViewModelReady() const
+{
+	return ViewModel != nullptr;
+}
+
+void UUIView::BindToActor(AActor* Actor)
+{
+	const auto WindowSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UWindowSubsystem>() : nullptr;
+	if(BoundActor.IsValid() && WindowSubsystem)
+	{
+		WindowSubsystem->UnregisterLODView(this);
+	}
+
+	BoundActor = Actor;
+	SetViewLOD(EUIViewLOD::Full);
+
+	if(Actor && WindowSubsystem)
+	{
+		WindowSubsystem->RegisterLODView(this);
+	}
+}
+
+AActor* UUIView::GetBoundActor() const
+{
+	return BoundActor.IsValid() ? BoundActor.Get() : nullptr;
+}
+
+EUIViewLOD UUIView::GetViewLOD() const
+{
+	return ViewLOD;
+}
+
+void UUIView::SetViewLOD(EUIViewLOD NewLOD)
+{
+	if(ViewLOD == NewLOD) return;
+
+	const EUIViewLOD OldLOD = ViewLOD;
+	ViewLOD = NewLOD;
+
+	if(GetDefault<UMVVMLibraryUISettings>()->bHideDormantViews)
+	{
+		if(NewLOD == EUIViewLOD::Dormant)
+		{
+			HideView();
+		}
+		else if(OldLOD == EUIViewLOD::Dormant)
+		{
+			ShowView();
+		}
+	}
+
+	if(ViewModel)
+	{
+		ViewModel->OnViewLODChanged(NewLOD);
+	}
+}
+
+void UUIView::SetViewModelData(UObject* Data)
+{
+	if(!ViewModel)
+	{
+		PendingViewModelData = Data;
+		return;
+	}
+
+	ViewModel->AssignData(Data);
+}
+
+void UUIView::RemoveFromParent()
+{
+	Super::RemoveFromParent();
+
+	//A detached view is destructed once its Slate widget is released
+	DetachedSlateWidget.Reset();
+}
+
+bool UUIView::IsViewHidden() const
+{
+	return bIsViewHidden || !IsVisible();
+}
+
+void UUIView::InvalidateView()
+{
+	//Default and Volatile views repaint on their own, only the cache of a Cached view has to be dropped
+	if(InvalidationPanel.IsValid())
+	{
+		InvalidationPanel->InvalidateRootLayout();
+	}
+}
+
+void UUIView::ShowView_Implementation()
+{
+	if(bIsViewHidden)
+	{
+		bIsViewHidden = false;
+
+		if(DetachedSlateWidget.IsValid())
+		{
+			//Reattaches the kept Slate widget instead of rebuilding the view
+			AddToViewport(static_cast<int32>(ViewLayer));
+			DetachedSlateWidget.Reset();
+		}
+		else if(HideMode == EUIViewHideMode::ZeroOpacity)
+		{
+			SetRenderOpacity(ShownRenderOpacity);
+		}
+	}
+
+	SetVisibility(ShownVisibility);
+}
+
+void UUIView::HideView_Implementation()
+{
+	if(bIsViewHidden) return;
+
+	bIsViewHidden = true;
+	
+	const EUIViewHideMode Mode = HideMode == EUIViewHideMode::Detached && (GetParent() || !IsInViewport())
+		? EUIViewHideMode::Collapsed
+		: HideMode;
+
+	switch (Mode)
+	{
+	case EUIViewHideMode::Hidden:
+		SetVisibility(ESlateVisibility::Hidden);
+		break;
+	case EUIViewHideMode::ZeroOpacity:
+		ShownRenderOpacity = GetRenderOpacity();
+		SetRenderOpacity(0.f);
+		SetVisibility(ESlateVisibility::HitTestInvisible);
+		break;
+	case EUIViewHideMode::Detached:
+		{
+			//Keeps the view constructed: its viewmodel stays attached and showing needs no rebuild
+			TSharedPtr<SWidget> SlateWidget = GetCachedWidget();
+			RemoveFromParent();
+			DetachedSlateWidget = MoveTemp(SlateWidget);
+			break;
+		}
+	default:
+		SetVisibility(ESlateVisibility::Collapsed);
+		break;
+	}
+}
+
+UObject* UUIView::GetSharedViewModelContext_Implementation() const
+{
+	return GetOwningPlayer();
+}
+
+void UUIView::CreateViewModel(UClass* InViewModelClass, UModelRepositorySubsystem* InModelRepository,
+                              UWorldModelRepositorySubsystem* InWorldModelRepository, UWindowSubsystem* InWindowSubsystem)
+{
+	const bool bIsShared = InWindowSubsystem && InViewModelClass->GetDefaultObject<UUIViewModel>()->bIsShared;
+	const UObject* SharedContext = bIsShared ? GetSharedViewModelContext() : nullptr;
+	if(bIsShared)
+	{
+		if(const auto SharedViewModel = InWindowSubsystem->FindSharedViewModel(InViewModelClass, SharedContext))
+		{
+			ViewModel = SharedViewModel;
+			ViewModel->AttachView(this);
+			ApplyPendingViewModelState();
+			return;
+		}
+	}
+
+	const bool bIsPoolable = !bIsShared && InWindowSubsystem && InViewModelClass->GetDefaultObject<UUIViewModel>()->bIsPoolable;
+	if(bIsPoolable)
+	{
+		ViewModel = InWindowSubsystem->TakePooledViewModel(InViewModelClass);
+	}
+
+	if(!ViewModel)
+	{
+		//Shared and pooled viewmodels may outlive this view, so they must not be outered to it
+		UObject* ViewModelOuter = bIsShared || bIsPoolable ? static_cast<UObject*>(InWindowSubsystem) : this;
+
+		MVVM_HITCH_SCOPE(ViewModelCreation, InViewModelClass);
+		ViewModel = NewObject<UUIViewModel>(ViewModelOuter, InViewModelClass);
+		if(bIsShared)
+		{
+			InWindowSubsystem->RegisterSharedViewModel(ViewModel, SharedContext);
+		}
+
+		ViewModel->BindServices(InWindowSubsystem);
+		ViewModel->SetModelRepository(InModelRepository);
+		ViewModel->SetWorldModelRepository(InWorldModelRepository);
+	}
+
+	ViewModel->InitializeViewModel(this);
+	ApplyPendingViewModelState();
+}
+
+void UUIView::ApplyPendingViewModelState()
+{
+	//A shared viewmodel holds one data item for all its views: as with SetViewModelData, the last assigned one wins
+	if(PendingViewModelData.IsValid())
+	{
+		ViewModel->AssignData(PendingViewModelData.Get());
+	}
+	PendingViewModelData.Reset();
+
+	if(!PendingRestoreState.IsEmpty())
+	{
+		ApplyRestoreState(MoveTemp(PendingRestoreState));
+	}
+}
+
+void UUIView::OnViewModelClassLoaded(UObject* LoadedClass)
+{
+	const auto ModelRepository = PendingModelRepository.Get();
+	const auto WorldModelRepository = PendingWorldModelRepository.Get();
+	const auto WindowSubsystem = PendingWindowSubsystem.Get();
+	PendingModelRepository.Reset();
+	PendingWorldModelRepository.Reset();
+	PendingWindowSubsystem.Reset();
+
+	//The view was destroyed (NativeDestruct resets the pending services) or the world was torn down while the class was streaming
+	if(ViewModel || !ModelRepository || !WorldModelRepository) return;
+
+	UClass* LoadedViewModelClass = Cast<UClass>(LoadedClass);
+	if(!ensureMsgf(LoadedViewModelClass && LoadedViewModelClass->IsChildOf<UUIViewModel>(), TEXT("Can not load viewmodel class %s of view %s"), *ViewModelClass.ToString(), *GetNameSafe(this)))
+	{
+		return;
+	}
+
+	CreateViewModel(LoadedViewModelClass, ModelRepository, WorldModelRepository, WindowSubsystem);
+}
+
+void UUIView::ApplyRestoreState(TArray<uint8>&& State)
+{
+	if(!ViewModel)
+	{
+		PendingRestoreState = MoveTemp(State);
+		return;
+	}
+
+	FMemoryReader Reader(State);
+	ViewModel->SerializeRestoreState(Reader);
+}
@@ -0,0 +1,353 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "Abstract/UIViewModel.h"
+#include "BlueprintEventMask.h"
+#include "Abstract/UIView.h"
+#include "Kismet/GameplayStatics.h"
+#include "WindowSubsystem.h"
+#include "WorldModelRepositorySubsystem.h"
+#include "ModelRepositorySubsystem.h"
+
+namespace UIViewModelEvents
+{
+	/** Index of the event in the name table of IsImplementedInBlueprint, which is also its bit in the mask */
+	enum EEvent : uint32
+	{
+		OnDestroyViewModel,
+		SetModelRepository,
+		SetWorldModelRepository,
+		InitializeViewModel,
+		OnViewAttached,
+		OnViewDetached,
+		AssignData,
+		ResetViewModel,
+		UpdateViewModel,
+		OnViewLODChanged,
+		Num
+	};
+}
+
+UModelRepositorySubsystem* UUIViewModel::GetModelRepository() const
+{
+	return ModelRepository.IsValid() ? ModelRepository.Get() : nullptr;
+}
+
+UWorldModelRepositorySubsystem* UUIViewModel::GetWorldModelRepository() const
+{
+	return WorldModelRepository.IsValid() ? WorldModelRepository.Get() : nullptr;
+}
+
+UWindowSubsystem* UUIViewModel::GetWindowSubsystem() const
+{
+	if(WindowSubsystem.IsValid())
+	{
+		return WindowSubsystem.Get();
+	}
+
+	if(const auto WorldContextObject = GetWorldContext())
+	{
+		return WorldContextObject->GetSubsystem<UWindowSubsystem>();
+	}
+
+	return nullptr;
+}
+
+APlayerController* UUIViewModel::GetOwningPlayer() const
+{
+	if(const auto View = GetOwnerView())
+	{
+		return View->GetOwningPlayer();
+	}
+
+	if(FallbackPlayerController.IsValid())
+	{
+		return FallbackPlayerController.Get();
+	}
+
+	if(const auto WorldContextObject = GetWorldContext())
+	{
+		FallbackPlayerController = UGameplayStatics::GetPlayerController(WorldContextObject, 0);
+		return FallbackPlayerController.Get();
+	}
+
+	return nullptr;
+}
+
+UUIView* UUIViewModel::GetOwnerView() const
+{
+	for (const auto& View : AttachedViews)
+	{
+		if(View.IsValid()) return View.Get();
+	}
+
+	return nullptr;
+}
+
+TArray<UUIView*> UUIViewModel::GetAttachedViews() const
+{
+	TArray<UUIView*> Views;
+	Views.Reserve(AttachedViews.Num());
+	for (const auto& View : AttachedViews)
+	{
+		if(View.IsValid()) Views.Add(View.Get());
+	}
+
+	return Views;
+}
+
+void UUIViewModel::NotifyViewChanged()
+{
+	for (const auto& View : AttachedViews)
+	{
+		if(View.IsValid()) View->InvalidateView();
+	}
+}
+
+UUIContextualModel* UUIViewModel::UseContextualModel(TSubclassOf<UUIContextualModel> ModelType)
+{
+	const auto Repository = GetWorldModelRepository();
+	return Repository ? Repository->AddModelReference(ModelType, this) : nullptr;
+}
+
+void UUIViewModel::StartCoroutine(FViewModelCoroutine&& Coroutine)
+{
+	if(Coroutine.Resume()) return;
+
+	Coroutines.Add(MoveTemp(Coroutine));
+	if(const auto Subsystem = GetWindowSubsystem())
+	{
+		Subsystem->RegisterCoroutineOwner(this);
+	}
+}
+
+void UUIViewModel::CancelCoroutines()
+{
+	if(bIsResumingCoroutines)
+	{
+		//The running coroutine can not be destroyed from inside itself
+		NumCancelledCoroutines = Coroutines.Num();
+		return;
+	}
+
+	Coroutines.Empty();
+}
+
+bool UUIViewModel::HasRunningCoroutines() const
+{
+	return Coroutines.Num() > NumCancelledCoroutines;
+}
+
+bool UUIViewModel::ResumeCoroutines()
+{
+	bIsResumingCoroutines = true;
+	//Coroutines started while resuming are appended and resumed in the next frame
+	const int32 NumCoroutines = Coroutines.Num();
+	for (int32 Index = 0; Index < NumCoroutines; ++Index)
+	{
+		//Cancelled by a coroutine resumed before
+		if(Index < NumCancelledCoroutines) break;
+
+		Coroutines[Index].Resume();
+	}
+	bIsResumingCoroutines = false;
+
+	if(NumCancelledCoroutines > 0)
+	{
+		Coroutines.RemoveAt(0, NumCancelledCoroutines);
+		NumCancelledCoroutines = 0;
+	}
+
+	Coroutines.RemoveAll([](const FViewModelCoroutine& Coroutine)
+	{
+		return Coroutine.IsDone();
+	});
+
+	return !Coroutines.IsEmpty();
+}
+
+void UUIViewModel::OnDestroyViewModel()
+{
+	CancelCoroutines();
+
+	if(const auto Repository = GetWorldModelRepository())
+	{
+		Repository->RemoveAllModelReferences(this);
+	}
+
+	if(IsImplementedInBlueprint(UIViewModelEvents::OnDestroyViewModel))
+	{
+		K2_OnDestroyViewModel();
+	}
+}
+
+void UUIViewModel::SetModelRepository(UModelRepositorySubsystem* InModelRepository)
+{
+	ModelRepository = InModelRepository;
+
+	if(IsImplementedInBlueprint(UIViewModelEvents::SetModelRepository))
+	{
+		K2_SetModelRepository(InModelRepository);
+	}
+}
+
+void UUIViewModel::SetWorldModelRepository(UWorldModelRepositorySubsystem* InWorldModelRepository)
+{
+	WorldModelRepository = InWorldModelRepository;
+
+	if(IsImplementedInBlueprint(UIViewModelEvents::SetWorldModelRepository))
+	{
+		K2_SetWorldModelRepository(InWorldModelRepository);
+	}
+}
+
+void UUIViewModel::InitializeViewModel(UUIView* View)
+{
+	check(View);
+	AttachedViews.Add(View);
+	
+	if(IsImplementedInBlueprint(UIViewModelEvents::InitializeViewModel))
+	{
+		K2_InitializeViewModel(View);
+	}
+}
+
+void UUIViewModel::OnViewAttached(UUIView* View)
+{
+	if(IsImplementedInBlueprint(UIViewModelEvents::OnViewAttached))
+	{
+		K2_OnViewAttached(View);
+	}
+}
+
+void UUIViewModel::OnViewDetached(UUIView* View)
+{
+	if(IsImplementedInBlueprint(UIViewModelEvents::OnViewDetached))
+	{
+		K2_OnViewDetached(View);
+	}
+}
+
+void UUIViewModel::SerializeRestoreState(FArchive& Ar)
+{
+}
+
+void UUIViewModel::AssignData(UObject* Data)
+{
+	AssignedData = Data;
+
+	if(IsImplementedInBlueprint(UIViewModelEvents::AssignData))
+	{
+		K2_AssignData(Data);
+	}
+}
+
+void UUIViewModel::ResetViewModel()
+{
+	AssignedData.Reset();
+
+	if(IsImplementedInBlueprint(UIViewModelEvents::ResetViewModel))
+	{
+		K2_ResetViewModel();
+	}
+}
+
+void UUIViewModel::UpdateViewModel(float DeltaTime)
+{
+	if(IsImplementedInBlueprint(UIViewModelEvents::UpdateViewModel))
+	{
+		K2_UpdateViewModel(DeltaTime);
+	}
+}
+
+void UUIViewModel::OnViewLODChanged(EUIViewLOD NewLOD)
+{
+	if(IsImplementedInBlueprint(UIViewModelEvents::OnViewLODChanged))
+	{
+		K2_OnViewLODChanged(NewLOD);
+	}
+}
+
+UObject* UUIViewModel::GetAssignedData() const
+{
+	return AssignedData.IsValid() ? AssignedData.Get() : nullptr;
+}
+
+void UUIViewModel::AttachView(UUIView* View)
+{
+	check(View);
+	AttachedViews.AddUnique(View);
+
+	OnViewAttached(View);
+}
+
+void UUIViewModel::DetachView(UUIView* View)
+{
+	const int32 ViewIndex = AttachedViews.IndexOfByKey(View);
+	if(ViewIndex == INDEX_NONE) return;
+
+	AttachedViews.RemoveAll([](const TWeakObjectPtr<UUIView>& AttachedView)
+	{
+		return !AttachedView.IsValid();
+	});
+
+	if(AttachedViews.Num() > 1)
+	{
+		AttachedViews.Remove(View);
+		OnViewDetached(View);
+		return;
+	}
+
+	if(bIsShared)
+	{
+		if(const auto Subsystem = GetWindowSubsystem())
+		{
+			Subsystem->UnregisterSharedViewModel(this);
+		}
+	}
+
+	//The last view stays reachable through GetOwnerView while the viewmodel is destroyed
+	OnDestroyViewModel();
+	AttachedViews.Reset();
+
+	if(bIsPoolable && !bIsShared)
+	{
+		ResetViewModel();
+		if(const auto Subsystem = GetWindowSubsystem())
+		{
+			Subsystem->ReturnViewModelToPool(this);
+		}
+	}
+}
+
+void UUIViewModel::BindServices(UWindowSubsystem* InWindowSubsystem)
+{
+	WindowSubsystem = InWindowSubsystem;
+	if(InWindowSubsystem)
+	{
+		BindWorldContext(InWindowSubsystem->GetWorld());
+	}
+}
+
+bool UUIViewModel::IsImplementedInBlueprint(uint32 Event)
+{
+	static const FName EventNames[] =
+	{
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_OnDestroyViewModel),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_SetModelRepository),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_SetWorldModelRepository),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_InitializeViewModel),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_OnViewAttached),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_OnViewDetached),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_AssignData),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_ResetViewModel),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_UpdateViewModel),
+		GET_FUNCTION_NAME_CHECKED(UUIViewModel, K2_OnViewLODChanged),
+	};
+	static_assert(UE_ARRAY_COUNT(EventNames) == UIViewModelEvents::Num, "Every event needs a name, in EEvent order");
+
+	return FBlueprintEventMask::IsImplemented(ImplementedBlueprintEvents, GetClass(), EventNames, Event);
+}
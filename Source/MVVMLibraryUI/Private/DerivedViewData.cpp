@@ -0,0 +1,50 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "DerivedViewData.h"
+
+#include "WindowSubsystem.h"
+#include "Abstract/UIViewModel.h"
+#include "Engine/World.h"
+
+UUIViewModel* FDerivedViewDataChannel::GetOwner() const
+{
+	return Owner.Get();
+}
+
+void FDerivedViewDataChannel::Register(UUIViewModel* InOwner)
+{
+	check(IsInGameThread());
+
+	Owner = InOwner;
+
+	const auto World = InOwner ? InOwner->GetWorld() : nullptr;
+	if(const auto Subsystem = UWorld::GetSubsystem<UWindowSubsystem>(World))
+	{
+		Queue = Subsystem->RegisterDerivedViewData(AsShared());
+	}
+}
+
+void FDerivedViewDataChannel::Unregister()
+{
+	check(IsInGameThread());
+
+	//Queue is left set: workers still running read it without a lock. Their results are dropped by the owner and generation check
+	NextGeneration();
+	Owner.Reset();
+}
+
+void FDerivedViewDataChannel::Enqueue(uint64 Generation, TUniqueFunction<void()>&& Apply)
+{
+	if(const auto PinnedQueue = Queue.Pin())
+	{
+		FDerivedViewDataResult Result;
+		Result.Channel = AsShared();
+		Result.Generation = Generation;
+		Result.Apply = MoveTemp(Apply);
+		PinnedQueue->Enqueue(MoveTemp(Result));
+	}
+}
@@ -0,0 +1,13 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "MVVMLibraryUISettings.h"
+
+UMVVMLibraryUISettings::UMVVMLibraryUISettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("MVVMLibraryUI");
+}
@@ -0,0 +1,170 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "PopUpTimingWheel.h"
+#include "Abstract/UIPopUpView.h"
+
+void FPopUpTimingWheel::Reset(double InStartTime, double InResolution)
+{
+	StartTime = InStartTime;
+	Resolution = FMath::Max(InResolution, UE_KINDA_SMALL_NUMBER);
+	CurrentTick = 0;
+
+	for (int32& SlotHead : SlotHeads)
+	{
+		SlotHead = INDEX_NONE;
+	}
+
+	Entries.Reset();
+	FreeEntries.Reset();
+	NumScheduled = 0;
+	bIsReset = true;
+}
+
+FPopUpTimerHandle FPopUpTimingWheel::Schedule(UUIPopUpView* PopUp, double ExpireTime)
+{
+	check(bIsReset);
+
+	int32 Index;
+	if(!FreeEntries.IsEmpty())
+	{
+		Index = FreeEntries.Pop();
+	}
+	else
+	{
+		Index = Entries.AddDefaulted();
+	}
+
+	auto& Entry = Entries[Index];
+	Entry.PopUp = PopUp;
+	Entry.ExpiryTick = ToTick(ExpireTime);
+	Entry.Serial = NextSerial++;
+	Entry.bScheduled = true;
+	Link(Index);
+	++NumScheduled;
+
+	FPopUpTimerHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Entry.Serial;
+	return Handle;
+}
+
+bool FPopUpTimingWheel::Reschedule(const FPopUpTimerHandle& Handle, double ExpireTime)
+{
+	if(!IsScheduled(Handle)) return false;
+
+	Unlink(Handle.Index);
+	Entries[Handle.Index].ExpiryTick = ToTick(ExpireTime);
+	Link(Handle.Index);
+	return true;
+}
+
+void FPopUpTimingWheel::Cancel(FPopUpTimerHandle& Handle)
+{
+	if(IsScheduled(Handle))
+	{
+		Unlink(Handle.Index);
+		Release(Handle.Index);
+	}
+
+	Handle.Invalidate();
+}
+
+bool FPopUpTimingWheel::IsScheduled(const FPopUpTimerHandle& Handle) const
+{
+	return Entries.IsValidIndex(Handle.Index)
+		&& Entries[Handle.Index].bScheduled
+		&& Entries[Handle.Index].Serial == Handle.Serial;
+}
+
+double FPopUpTimingWheel::GetRemainingTime(const FPopUpTimerHandle& Handle, double Now) const
+{
+	if(!IsScheduled(Handle)) return 0.0;
+
+	const double ExpireTime = StartTime + Entries[Handle.Index].ExpiryTick * Resolution;
+	return FMath::Max(ExpireTime - Now, 0.0);
+}
+
+void FPopUpTimingWheel::Advance(double Now, TArray<TWeakObjectPtr<UUIPopUpView>>& OutExpired)
+{
+	if(!bIsReset) return;
+
+	const int64 TargetTick = FMath::FloorToInt64((Now - StartTime) / Resolution);
+	if(TargetTick <= CurrentTick) return;
+
+	//After a long stall every slot is visited once
+	const int64 NumSteps = FMath::Min<int64>(TargetTick - CurrentTick, NumSlots);
+	for (int64 Step = 1; Step <= NumSteps && NumScheduled > 0; ++Step)
+	{
+		const int32 Slot = static_cast<int32>((CurrentTick + Step) % NumSlots);
+		int32 Index = SlotHeads[Slot];
+		while(Index != INDEX_NONE)
+		{
+			const int32 NextIndex = Entries[Index].Next;
+			//Entries of later revolutions stay in the slot
+			if(Entries[Index].ExpiryTick <= TargetTick)
+			{
+				OutExpired.Add(Entries[Index].PopUp);
+				Unlink(Index);
+				Release(Index);
+			}
+			Index = NextIndex;
+		}
+	}
+
+	CurrentTick = TargetTick;
+}
+
+int64 FPopUpTimingWheel::ToTick(double Time) const
+{
+	//An expiry in the past or in the current tick fires on the next Advance
+	const int64 Tick = FMath::CeilToInt64((Time - StartTime) / Resolution);
+	return FMath::Max(Tick, CurrentTick + 1);
+}
+
+void FPopUpTimingWheel::Link(int32 Index)
+{
+	auto& Entry = Entries[Index];
+	const int32 Slot = static_cast<int32>(Entry.ExpiryTick % NumSlots);
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = SlotHeads[Slot];
+	if(Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Index;
+	}
+	SlotHeads[Slot] = Index;
+}
+
+void FPopUpTimingWheel::Unlink(int32 Index)
+{
+	auto& Entry = Entries[Index];
+	if(Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		SlotHeads[Entry.ExpiryTick % NumSlots] = Entry.Next;
+	}
+
+	if(Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+void FPopUpTimingWheel::Release(int32 Index)
+{
+	auto& Entry = Entries[Index];
+	Entry.PopUp.Reset();
+	Entry.bScheduled = false;
+	FreeEntries.Add(Index);
+	--NumScheduled;
+}
@@ -0,0 +1,37 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abstract/UIView.h"
+#include "Abstract/UIViewModel.h"
+#include "MVVMTestViews.generated.h"
+
+/**
+ * Concrete window with the base viewmodel for automation tests.
+ */
+UCLASS(Transient, HideDropdown, NotBlueprintable)
+class UMVVMTestView : public UUIView
+{
+	GENERATED_BODY()
+
+public:
+
+	UMVVMTestView(const FObjectInitializer& ObjectInitializer)
+		: Super(ObjectInitializer)
+	{
+		ViewModelClass = UUIViewModel::StaticClass();
+	}
+};
+
+/**
+ * Second window class, never opened by the tests.
+ */
+UCLASS(Transient, HideDropdown, NotBlueprintable)
+class UMVVMTestClosedView : public UMVVMTestView
+{
+	GENERATED_BODY()
+};
@@ -0,0 +1,77 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/MVVMTestViews.h"
+#include "Tests/MVVMTestUtilities.h"
+#include "WindowSubsystem.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWindowSubsystemLookupAllocationTest, "MVVMLibrary.Allocations.WindowSubsystemLookups",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FWindowSubsystemLookupAllocationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCalls = 1000;
+
+	//A standalone world has no game viewport to attach the window to
+	AddExpectedError(TEXT("No game viewport found"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	FMVVMTestWorld TestWorld;
+	const auto WindowSubsystem = TestWorld.GetWorld()->GetSubsystem<UWindowSubsystem>();
+	if(!TestNotNull(TEXT("Window subsystem"), WindowSubsystem)) return false;
+
+	const TSubclassOf<UUIView> OpenType = UMVVMTestView::StaticClass();
+	const TSubclassOf<UUIView> ClosedType = UMVVMTestClosedView::StaticClass();
+
+	//Warm-up: creates the window, its viewmodel and the map entries
+	const auto Window = WindowSubsystem->OpenWindow(OpenType);
+	if(!TestNotNull(TEXT("Opened window"), Window)) return false;
+	WindowSubsystem->CloseWindow(ClosedType);
+	WindowSubsystem->IsOpen(OpenType);
+	WindowSubsystem->IsOpen(ClosedType);
+
+	{
+		FMVVMScopedAllocationCounter Allocations;
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			WindowSubsystem->OpenWindow(OpenType);
+		}
+		TestEqual(TEXT("Allocations of OpenWindow of an open class"), Allocations.GetNumAllocations(), 0);
+	}
+
+	{
+		FMVVMScopedAllocationCounter Allocations;
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			WindowSubsystem->CloseWindow(ClosedType);
+		}
+		TestEqual(TEXT("Allocations of CloseWindow of a closed class"), Allocations.GetNumAllocations(), 0);
+	}
+
+	{
+		FMVVMScopedAllocationCounter Allocations;
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			WindowSubsystem->IsOpen(OpenType);
+			WindowSubsystem->IsOpen(ClosedType);
+			WindowSubsystem->IsWindowOpen(Window);
+		}
+		TestEqual(TEXT("Allocations of IsOpen"), Allocations.GetNumAllocations(), 0);
+	}
+
+	TestTrue(TEXT("OpenWindow of an open class returns the open window"), WindowSubsystem->OpenWindow(OpenType) == Window);
+	TestTrue(TEXT("Window is open"), WindowSubsystem->IsOpen(OpenType));
+	TestFalse(TEXT("Closed class is not open"), WindowSubsystem->IsOpen(ClosedType));
+	TestTrue(TEXT("CloseWindow of an open class"), WindowSubsystem->CloseWindow(OpenType));
+	TestFalse(TEXT("Window is closed"), WindowSubsystem->IsOpen(OpenType));
+
+	return true;
+}
+
+#endif
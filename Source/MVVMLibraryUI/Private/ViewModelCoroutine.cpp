@@ -0,0 +1,114 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "ViewModelCoroutine.h"
+
+#include "WindowSubsystem.h"
+#include "Abstract/UIPopUpView.h"
+#include "Abstract/UIView.h"
+#include "Engine/World.h"
+
+FViewModelCoroutine::~FViewModelCoroutine()
+{
+	if(Handle)
+	{
+		Handle.destroy();
+	}
+}
+
+FViewModelCoroutine& FViewModelCoroutine::operator=(FViewModelCoroutine&& Other)
+{
+	if(this != &Other)
+	{
+		if(Handle)
+		{
+			Handle.destroy();
+		}
+		Handle = Other.Handle;
+		Other.Handle = nullptr;
+	}
+
+	return *this;
+}
+
+bool FViewModelCoroutine::Resume()
+{
+	if(IsDone()) return true;
+
+	//The owning array may grow while the coroutine runs, so only the local handle is used after resuming
+	const FHandle LocalHandle = Handle;
+	const auto Awaiter = LocalHandle.promise().Awaiter;
+	if(Awaiter && !Awaiter->IsReady()) return false;
+
+	LocalHandle.promise().Awaiter = nullptr;
+	LocalHandle.resume();
+	return LocalHandle.done();
+}
+
+bool FViewModelCoroutine::IsDone() const
+{
+	return !Handle || Handle.done();
+}
+
+FWaitNextFrame::FWaitNextFrame()
+	: StartFrame(GFrameCounter)
+{
+}
+
+bool FWaitNextFrame::IsReady() const
+{
+	return GFrameCounter > StartFrame;
+}
+
+FWaitSeconds::FWaitSeconds(const UObject* WorldContext, float Seconds)
+	: World(WorldContext ? WorldContext->GetWorld() : nullptr)
+{
+	if(World.IsValid())
+	{
+		ResumeTime = World->GetTimeSeconds() + Seconds;
+	}
+}
+
+bool FWaitSeconds::IsReady() const
+{
+	return !World.IsValid() || World->GetTimeSeconds() >= ResumeTime;
+}
+
+FWaitForWindowReady::FWaitForWindowReady(UUIView* InWindow)
+	: Window(InWindow)
+{
+}
+
+bool FWaitForWindowReady::IsReady() const
+{
+	return !Window.IsValid() || Window->IsViewModelReady();
+}
+
+UUIView* FWaitForWindowReady::await_resume() const
+{
+	return Window.Get();
+}
+
+FWaitForWindowClosed::FWaitForWindowClosed(UUIView* InWindow)
+	: Window(InWindow)
+	, WindowSubsystem(InWindow ? UWorld::GetSubsystem<UWindowSubsystem>(InWindow->GetWorld()) : nullptr)
+{
+}
+
+bool FWaitForWindowClosed::IsReady() const
+{
+	return !Window.IsValid() || !WindowSubsystem.IsValid() || !WindowSubsystem->IsWindowOpen(Window.Get());
+}
+
+FWaitForPopUpDestroyed::FWaitForPopUpDestroyed(UUIPopUpView* InPopUp)
+	: PopUp(InPopUp)
+{
+}
+
+bool FWaitForPopUpDestroyed::IsReady() const
+{
+	return !PopUp.IsValid() || PopUp->IsPopUpDestroyed();
+}
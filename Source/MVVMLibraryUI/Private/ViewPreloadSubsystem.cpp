@@ -0,0 +1,140 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "ViewPreloadSubsystem.h"
+
+#include "Abstract/UIView.h"
+#include "MVVMLibraryUISettings.h"
+
+bool UViewPreloadSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UViewPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &ThisClass::OnPreLoadMap);
+}
+
+void UViewPreloadSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMapWithContext.Remove(PreLoadMapHandle);
+
+	for (auto& [GroupName, Handles] : PreloadGroups)
+	{
+		if(Handles.ViewsHandle) Handles.ViewsHandle->CancelHandle();
+		if(Handles.AssetsHandle) Handles.AssetsHandle->CancelHandle();
+	}
+	PreloadGroups.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UViewPreloadSubsystem::PreloadGroup(FName GroupName)
+{
+	const auto GroupSettings = GetDefault<UMVVMLibraryUISettings>()->ViewPreloadGroups.Find(GroupName);
+	if(!GroupSettings) return false;
+	if(PreloadGroups.Contains(GroupName)) return true;
+
+	TArray<FSoftObjectPath> ViewPaths;
+	ViewPaths.Reserve(GroupSettings->Views.Num());
+	for (const auto& ViewPath : GroupSettings->Views)
+	{
+		if(ViewPath.IsValid()) ViewPaths.Add(ViewPath);
+	}
+
+	auto& Handles = PreloadGroups.Add(GroupName);
+	Handles.ViewsHandle = StreamableManager.RequestAsyncLoad(MoveTemp(ViewPaths), FStreamableDelegate::CreateUObject(this, &ThisClass::OnGroupViewsLoaded, GroupName));
+	if(!Handles.ViewsHandle)
+	{
+		//Nothing to load
+		Handles.bIsLoaded = true;
+	}
+
+	return true;
+}
+
+void UViewPreloadSubsystem::ReleasePreloadGroup(FName GroupName)
+{
+	FPreloadGroupHandles Handles;
+	if(!PreloadGroups.RemoveAndCopyValue(GroupName, Handles)) return;
+
+	ReleaseHandle(Handles.ViewsHandle);
+	ReleaseHandle(Handles.AssetsHandle);
+}
+
+void UViewPreloadSubsystem::ReleaseHandle(const TSharedPtr<FStreamableHandle>& Handle)
+{
+	if(!Handle) return;
+
+	//A load still in flight is cancelled, so its completion delegate, keyed only by the group name, never reaches
+	//a group preloaded again after this release
+	if(Handle->HasLoadCompleted())
+	{
+		Handle->ReleaseHandle();
+	}
+	else
+	{
+		Handle->CancelHandle();
+	}
+}
+
+bool UViewPreloadSubsystem::IsPreloadGroupLoaded(FName GroupName) const
+{
+	const auto Handles = PreloadGroups.Find(GroupName);
+	return Handles && Handles->bIsLoaded;
+}
+
+void UViewPreloadSubsystem::OnPreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
+{
+	if(WorldContext.OwningGameInstance != GetGameInstance()) return;
+
+	for (const auto& [GroupName, GroupSettings] : GetDefault<UMVVMLibraryUISettings>()->ViewPreloadGroups)
+	{
+		if(GroupSettings.bPreloadOnMapLoad)
+		{
+			PreloadGroup(GroupName);
+		}
+	}
+}
+
+void UViewPreloadSubsystem::OnGroupViewsLoaded(FName GroupName)
+{
+	const auto Handles = PreloadGroups.Find(GroupName);
+	if(!Handles || !Handles->ViewsHandle || Handles->bIsLoaded || Handles->AssetsHandle) return;
+
+	TArray<UObject*> LoadedViews;
+	Handles->ViewsHandle->GetLoadedAssets(LoadedViews);
+
+	TArray<FSoftObjectPath> Assets;
+	for (const auto LoadedView : LoadedViews)
+	{
+		const auto ViewClass = Cast<UClass>(LoadedView);
+		if(!ViewClass || !ViewClass->IsChildOf<UUIView>()) continue;
+
+		ViewClass->GetDefaultObject<UUIView>()->CollectPreloadAssets(Assets);
+	}
+
+	if(Assets.IsEmpty())
+	{
+		Handles->bIsLoaded = true;
+		return;
+	}
+
+	Handles->AssetsHandle = StreamableManager.RequestAsyncLoad(MoveTemp(Assets), FStreamableDelegate::CreateWeakLambda(this, [this, GroupName]()
+	{
+		if(const auto LoadedHandles = PreloadGroups.Find(GroupName))
+		{
+			LoadedHandles->bIsLoaded = true;
+		}
+	}));
+	if(!Handles->AssetsHandle)
+	{
+		Handles->bIsLoaded = true;
+	}
+}
@@ -0,0 +1,33 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "WindowStateSubsystem.h"
+
+void UWindowStateSubsystem::StoreSnapshot(FWindowSetSnapshot&& Snapshot)
+{
+	StoredSnapshot = MoveTemp(Snapshot);
+	bHasStoredSnapshot = true;
+}
+
+bool UWindowStateSubsystem::TakeSnapshot(FWindowSetSnapshot& OutSnapshot)
+{
+	if(!bHasStoredSnapshot) return false;
+
+	OutSnapshot = MoveTemp(StoredSnapshot);
+	ClearStoredSnapshot();
+	return true;
+}
+
+bool UWindowStateSubsystem::HasStoredSnapshot() const
+{
+	return bHasStoredSnapshot;
+}
+
+void UWindowStateSubsystem::ClearStoredSnapshot()
+{
+	StoredSnapshot = FWindowSetSnapshot();
+	bHasStoredSnapshot = false;
+}
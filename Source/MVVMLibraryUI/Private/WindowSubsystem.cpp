@@ -0,0 +1,1175 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+
+#include "WindowSubsystem.h"
+
+#include "Abstract/UIView.h"
+#include "Abstract/UIViewModel.h"
+#include "WorldModelRepositorySubsystem.h"
+#include "ModelRepositorySubsystem.h"
+#include "Abstract/UIPopUpView.h"
+#include "WindowStateSubsystem.h"
+#include "PopUpTimingWheel.h"
+#include "DerivedViewData.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+#include "Components/PanelWidget.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "MVVMLibraryUISettings.h"
+#include "MVVMHitchTracker.h"
+#include "Misc/App.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogWindowSubsystem, Log, All);
+
+UWindowSubsystem::UWindowSubsystem()
+	//Constructed here, so the header only forward declares them
+	: PopUpLifeSpans(MakePimpl<FPopUpTimingWheel>())
+	, DerivedViewDataResults(MakeShared<FDerivedViewDataQueue, ESPMode::ThreadSafe>())
+{
+}
+
+bool UWindowSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	//Dedicated servers never draw UI
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWindowSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	//Bind both repositories once per world, so opening views never has to resolve them again
+	WorldModelRepositoryCache = Collection.InitializeDependency<UWorldModelRepositorySubsystem>();
+	if(const auto GameInstance = GetWorld()->GetGameInstance())
+	{
+		ModelRepositoryCache = GameInstance->GetSubsystem<UModelRepositorySubsystem>();
+	}
+
+	PopUpLifeSpans->Reset(GetWorld()->GetTimeSeconds(), GetDefault<UMVVMLibraryUISettings>()->PopUpLifeSpanResolution);
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &ThisClass::OnPreLoadMap);
+	SeamlessTravelStartHandle = FWorldDelegates::OnSeamlessTravelStart.AddUObject(this, &ThisClass::OnSeamlessTravelStart);
+}
+
+void UWindowSubsystem::Deinitialize()
+{
+	PendingPrewarmHints.Empty();
+	PrewarmedWindows.Empty();
+	PendingWindowAttachments.Empty();
+	WindowBatchDepth = 0;
+	PendingRestoreWindows.Empty();
+	SharedViewModels.Empty();
+	ViewModelPools.Empty();
+	LODViews.Empty();
+	NotificationQueue.Empty();
+	ActiveNotifications.Empty();
+	ActiveNotificationCounts.Empty();
+	PopUpLifeSpans->Reset(0.0, GetDefault<UMVVMLibraryUISettings>()->PopUpLifeSpanResolution);
+	ExpiredPopUps.Empty();
+	CoroutineOwners.Empty();
+	DerivedViewDataChannels.Empty();
+	DerivedViewDataResults->Empty();
+
+	FCoreUObjectDelegates::PreLoadMapWithContext.Remove(PreLoadMapHandle);
+	FWorldDelegates::OnSeamlessTravelStart.Remove(SeamlessTravelStartHandle);
+	
+	ModelRepositoryCache.Reset();
+	WorldModelRepositoryCache.Reset();
+	
+	Super::Deinitialize();
+}
+
+void UWindowSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if(GetDefault<UMVVMLibraryUISettings>()->bRestoreWindowsAfterTravel)
+	{
+		RestoreWindowState();
+	}
+}
+
+void UWindowSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	//A batch never spans frames: windows opened in a batch that was not ended would stay detached forever
+	if(WindowBatchDepth > 0)
+	{
+		UE_LOG(LogWindowSubsystem, Error, TEXT("A window batch is still open at the end of the frame. BeginWindowBatch is missing a matching EndWindowBatch, the batch is committed"));
+		WindowBatchDepth = 0;
+		CommitWindowBatch();
+	}
+
+	ProcessWindowRestore();
+	ProcessViewLOD(DeltaTime);
+	ProcessPopUpLifeSpans();
+	ProcessDerivedViewData();
+	ProcessViewModelCoroutines();
+	ProcessNotificationQueue();
+	DiscardExpiredPrewarmedWindows();
+	ProcessPrewarmHints();
+}
+
+TStatId UWindowSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWindowSubsystem, STATGROUP_Tickables);
+}
+
+bool UWindowSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWindowSubsystem::K2_OpenWindow(UUIView*& OutWindow, bool& bResult, TSubclassOf<UUIView> WindowType,
+                                     APlayerController* Owner)
+{
+	OutWindow = OpenWindow(MoveTemp(WindowType), Owner);
+	bResult = OutWindow != nullptr;
+}
+
+void UWindowSubsystem::K2_CreatePopUp(UUIPopUpView*& OutPopUp, bool& bResult, TSubclassOf<UUIPopUpView> PopUpType,
+	APlayerController* Owner, UPanelWidget* ParentWidget)
+{
+	OutPopUp = CreatePopUp(MoveTemp(PopUpType), Owner, ParentWidget);
+	bResult = OutPopUp != nullptr;
+}
+
+UUIView* UWindowSubsystem::OpenWindow(TSubclassOf<UUIView> WindowType, APlayerController* Owner)
+{
+	if(IsRunningDedicatedServer() || !GetWorld() || !IsValid(WindowType)) return nullptr;
+
+	if(const auto OpenedWindow = OpenedWindows.Find(WindowType))
+	{
+		return *OpenedWindow;
+	}
+	
+	//Keeps a prebuilt Slate widget alive until the window is attached
+	TSharedPtr<SWidget> PreparedSlateWidget;
+	auto Window = TakePrewarmedWindow(WindowType, Owner, PreparedSlateWidget);
+	if(!Window)
+	{
+		Window = CreateWindow(WindowType, Owner);
+	}
+	OpenedWindows.Add(WindowType, Window);
+
+	if(WindowBatchDepth > 0)
+	{
+		auto& Attachment = PendingWindowAttachments.AddDefaulted_GetRef();
+		Attachment.Window = Window;
+		Attachment.SlateWidget = MoveTemp(PreparedSlateWidget);
+		return Window;
+	}
+	
+	AttachWindow(Window);
+	InitializeExistsView(Window);
+
+	return Window;
+}
+
+TArray<UUIView*> UWindowSubsystem::OpenWindows(const TArray<TSubclassOf<UUIView>>& WindowTypes, APlayerController* Owner)
+{
+	TArray<UUIView*> Windows;
+	Windows.Reserve(WindowTypes.Num());
+
+	FScopedWindowBatch WindowBatch(this);
+	for (const auto& WindowType : WindowTypes)
+	{
+		if(const auto Window = OpenWindow(WindowType, Owner))
+		{
+			Windows.Add(Window);
+		}
+	}
+
+	return Windows;
+}
+
+bool UWindowSubsystem::CloseWindow(TSubclassOf<UUIView> WindowType)
+{
+	if(IsRunningDedicatedServer()) return false;
+	
+	UUIView* FindWindow = nullptr;
+	if(OpenedWindows.RemoveAndCopyValue(WindowType, FindWindow))
+	{
+		if(WindowBatchDepth > 0)
+		{
+			//A window opened in this batch is simply never attached
+			PendingWindowAttachments.RemoveAll([FindWindow](const FPendingWindowAttachment& Attachment)
+			{
+				return Attachment.Window == FindWindow;
+			});
+		}
+		
+		if(FindWindow)
+			FindWindow->RemoveFromParent();
+		
+		return true;
+	}
+
+	return false;
+}
+
+void UWindowSubsystem::CloseWindows(const TArray<TSubclassOf<UUIView>>& WindowTypes)
+{
+	FScopedWindowBatch WindowBatch(this);
+	for (const auto& WindowType : WindowTypes)
+	{
+		CloseWindow(WindowType);
+	}
+}
+
+void UWindowSubsystem::CloseAllWindows()
+{
+	if(IsRunningDedicatedServer()) return;
+
+	//Detach the whole set first: removing a window may run game code that opens or closes other windows
+	auto WindowsToClose = MoveTemp(OpenedWindows);
+	OpenedWindows.Reset();
+	PendingWindowAttachments.Reset();
+	
+	for (const auto& [WindowType, Window] : WindowsToClose)
+	{
+		if(Window)
+		{
+			Window->RemoveFromParent();
+		}
+	} 
+}
+
+void UWindowSubsystem::BeginWindowBatch()
+{
+	++WindowBatchDepth;
+}
+
+void UWindowSubsystem::EndWindowBatch()
+{
+	if(!ensureMsgf(WindowBatchDepth > 0, TEXT("EndWindowBatch is called without BeginWindowBatch"))) return;
+
+	if(--WindowBatchDepth == 0)
+	{
+		CommitWindowBatch();
+	}
+}
+
+bool UWindowSubsystem::IsInWindowBatch() const
+{
+	return WindowBatchDepth > 0;
+}
+
+bool UWindowSubsystem::IsOpen(TSubclassOf<UUIView> WindowType) const
+{
+	if(!IsValid(WindowType))
+		return false;
+	
+	return OpenedWindows.Contains(WindowType);
+}
+
+bool UWindowSubsystem::IsWindowOpen(const UUIView* Window) const
+{
+	if(!IsValid(Window))
+		return false;
+
+	const auto OpenedWindow = OpenedWindows.Find(Window->GetClass());
+	return OpenedWindow && *OpenedWindow == Window;
+}
+
+void UWindowSubsystem::InitializeExistsView(UUIView* ExistedView)
+{
+	if(IsRunningDedicatedServer() || !ExistedView || ExistedView->IsInitializedView()) return;
+
+	const auto WorldModelRepositorySubsystem = GetWorldModelRepository();
+	const auto ModelRepositorySubsystem = GetModelRepository();
+	check(ModelRepositorySubsystem && WorldModelRepositorySubsystem);
+
+	ExistedView->InitializeView(ModelRepositorySubsystem, WorldModelRepositorySubsystem, this);
+}
+
+void UWindowSubsystem::PrewarmWindow(TSubclassOf<UUIView> WindowType, float LikelyWithinSeconds, APlayerController* Owner)
+{
+	if(IsRunningDedicatedServer() || !GetWorld() || !IsValid(WindowType)) return;
+	if(GetDefault<UMVVMLibraryUISettings>()->MaxPrewarmedWindows <= 0) return;
+	if(OpenedWindows.Contains(WindowType)) return;
+
+	const double ExpirationTime = GetWorld()->GetRealTimeSeconds() + FMath::Max(LikelyWithinSeconds, 0.f);
+	if(const auto Prepared = PrewarmedWindows.Find(WindowType))
+	{
+		Prepared->ExpirationTime = FMath::Max(Prepared->ExpirationTime, ExpirationTime);
+		return;
+	}
+
+	PendingPrewarmHints.RemoveAll([&WindowType](const FWindowPrewarmHint& Hint)
+	{
+		return Hint.WindowType == WindowType;
+	});
+
+	FWindowPrewarmHint Hint;
+	Hint.WindowType = WindowType;
+	Hint.Owner = Owner;
+	Hint.ExpirationTime = ExpirationTime;
+
+	//The window needed soonest is prepared first
+	const int32 Index = Algo::UpperBoundBy(PendingPrewarmHints, ExpirationTime, &FWindowPrewarmHint::ExpirationTime);
+	PendingPrewarmHints.Insert(MoveTemp(Hint), Index);
+}
+
+void UWindowSubsystem::CancelPrewarm(TSubclassOf<UUIView> WindowType)
+{
+	PendingPrewarmHints.RemoveAll([&WindowType](const FWindowPrewarmHint& Hint)
+	{
+		return Hint.WindowType == WindowType;
+	});
+	
+	PrewarmedWindows.Remove(WindowType);
+}
+
+bool UWindowSubsystem::IsPrewarmed(TSubclassOf<UUIView> WindowType) const
+{
+	if(!IsValid(WindowType))
+		return false;
+	
+	return PrewarmedWindows.Contains(WindowType);
+}
+
+void UWindowSubsystem::CaptureWindowState()
+{
+	const auto WindowStateSubsystem = GetWindowStateSubsystem();
+	if(IsRunningDedicatedServer() || !WindowStateSubsystem) return;
+
+	const auto& LocalPlayers = GetWorld()->GetGameInstance()->GetLocalPlayers();
+	
+	FWindowSetSnapshot Snapshot;
+	Snapshot.bIsHiddenAllWindows = bIsHiddenAllWindows;
+	Snapshot.Windows.Reserve(OpenedWindows.Num());
+	for (const auto& [WindowType, Window] : OpenedWindows)
+	{
+		if(!IsValid(Window)) continue;
+
+		auto& Descriptor = Snapshot.Windows.AddDefaulted_GetRef();
+		Descriptor.WindowType = WindowType;
+		Descriptor.Layer = Window->GetUILayer();
+		Descriptor.LocalPlayerIndex = LocalPlayers.IndexOfByKey(Window->GetOwningLocalPlayer());
+		//While all windows are hidden the own state of a window is unknown
+		Descriptor.bIsHidden = !bIsHiddenAllWindows && Window->IsViewHidden();
+
+		if(Window->ViewModel)
+		{
+			FMemoryWriter Writer(Descriptor.ViewModelState);
+			Window->ViewModel->SerializeRestoreState(Writer);
+		}
+		else
+		{
+			//Viewmodel class is still streaming: keep the state the window was restored with
+			Descriptor.ViewModelState = Window->PendingRestoreState;
+		}
+	}
+
+	//Lower layers are restored first
+	Algo::StableSortBy(Snapshot.Windows, [](const FWindowDescriptor& Descriptor)
+	{
+		return static_cast<int32>(Descriptor.Layer);
+	});
+
+	WindowStateSubsystem->StoreSnapshot(MoveTemp(Snapshot));
+}
+
+void UWindowSubsystem::RestoreWindowState()
+{
+	const auto WindowStateSubsystem = GetWindowStateSubsystem();
+	if(IsRunningDedicatedServer() || !WindowStateSubsystem) return;
+
+	FWindowSetSnapshot Snapshot;
+	if(!WindowStateSubsystem->TakeSnapshot(Snapshot)) return;
+
+	if(Snapshot.bIsHiddenAllWindows)
+	{
+		HideAllWindows();
+	}
+
+	PendingRestoreWindows = MoveTemp(Snapshot.Windows);
+	RestoreStartTime = GetWorld()->GetRealTimeSeconds();
+}
+
+bool UWindowSubsystem::IsRestoringWindows() const
+{
+	return !PendingRestoreWindows.IsEmpty();
+}
+
+void UWindowSubsystem::HideAllWindows()
+{
+	if(bIsHiddenAllWindows) return;
+	
+	bIsHiddenAllWindows = true;
+	for (const auto& WindowPair : OpenedWindows)
+	{
+		WindowPair.Value->HideView();
+	} 
+}
+
+void UWindowSubsystem::ShowAllWindows()
+{
+	if(!bIsHiddenAllWindows) return;
+	
+	bIsHiddenAllWindows = false;
+	for (const auto& WindowPair : OpenedWindows)
+	{
+		WindowPair.Value->ShowView();
+	}
+}
+
+UUIPopUpView* UWindowSubsystem::CreatePopUp(TSubclassOf<UUIPopUpView> PopUpType, APlayerController* Owner, UPanelWidget* ParentWidget)
+{
+	if(IsRunningDedicatedServer() || !GetWorld() || !IsValid(PopUpType)) return nullptr;
+
+	const auto PopUp = SpawnPopUp(PopUpType, Owner, ParentWidget);
+	if(!PopUp) return nullptr;
+
+	const auto WorldModelRepositorySubsystem = GetWorldModelRepository();
+	const auto ModelRepositorySubsystem = GetModelRepository();
+	PopUp->InitializePopUp(ModelRepositorySubsystem, WorldModelRepositorySubsystem);
+
+	return PopUp;
+}
+
+UUIPopUpView* UWindowSubsystem::SpawnPopUp(const TSubclassOf<UUIPopUpView>& PopUpType, APlayerController* Owner, UPanelWidget* ParentWidget) const
+{
+	MVVM_HITCH_SCOPE(ViewCreation, PopUpType);
+
+	//Several pop-ups of one class may be shown at once, so every instance gets its own generated name
+	UUIPopUpView* PopUp = nullptr;
+	if(IsValid(Owner))
+	{
+		PopUp = Cast<UUIPopUpView>(CreateWidget(Owner, PopUpType));
+	}
+	else
+	{
+		PopUp = Cast<UUIPopUpView>(CreateWidget(GetWorld(), PopUpType));
+	}
+	if(!PopUp) return nullptr;
+	
+	if(IsValid(ParentWidget))
+	{
+		ParentWidget->AddChild(PopUp);
+	}
+	else
+	{
+		PopUp->AddToViewport(static_cast<int32>(PopUp->GetUILayer()));
+	}
+
+	return PopUp;
+}
+
+UUIPopUpView* UWindowSubsystem::PushNotification(TSubclassOf<UUIPopUpView> PopUpType, FName Key, int32 Priority,
+	UObject* Payload, APlayerController* Owner, UPanelWidget* ParentWidget)
+{
+	if(IsRunningDedicatedServer() || !GetWorld() || !IsValid(PopUpType)) return nullptr;
+
+	if(!Key.IsNone())
+	{
+		//Merge into the shown pop-up with the same key
+		if(const auto* ActivePopUp = ActiveNotifications.Find(MakeTuple(FObjectKey(PopUpType), Key)))
+		{
+			if(const auto PopUp = ActivePopUp->Get())
+			{
+				++PopUp->NotificationCount;
+				PopUp->OnNotificationCoalesced(PopUp->NotificationCount, Payload);
+				return PopUp;
+			}
+		}
+
+		//Merge into the queued notification with the same key
+		const int32 QueuedIndex = NotificationQueue.IndexOfByPredicate([&PopUpType, &Key](const FPendingNotification& Notification)
+		{
+			return Notification.PopUpType == PopUpType && Notification.Key == Key;
+		});
+		if(QueuedIndex != INDEX_NONE)
+		{
+			auto Notification = MoveTemp(NotificationQueue[QueuedIndex]);
+			NotificationQueue.RemoveAt(QueuedIndex);
+			
+			++Notification.Count;
+			Notification.Priority = FMath::Max(Notification.Priority, Priority);
+			Notification.Payload = Payload;
+			EnqueueNotification(MoveTemp(Notification));
+			return nullptr;
+		}
+	}
+
+	FPendingNotification Notification;
+	Notification.PopUpType = MoveTemp(PopUpType);
+	Notification.Owner = Owner;
+	Notification.ParentWidget = ParentWidget;
+	Notification.Payload = Payload;
+	Notification.Key = Key;
+	Notification.Priority = Priority;
+	Notification.Sequence = NextNotificationSequence++;
+
+	//Queued notifications of the same or higher priority are shown first, unless their class is at its limit and they would keep waiting
+	const bool bHasQueuedAhead = NotificationQueue.ContainsByPredicate([this, Priority](const FPendingNotification& Queued)
+	{
+		return Queued.Priority >= Priority && IsValid(Queued.PopUpType) && HasNotificationCapacity(Queued.PopUpType);
+	});
+	if(!bHasQueuedAhead && HasNotificationCapacity(Notification.PopUpType) && HasNotificationSpawnBudget())
+	{
+		return SpawnNotification(Notification);
+	}
+
+	EnqueueNotification(MoveTemp(Notification));
+	return nullptr;
+}
+
+void UWindowSubsystem::ClearNotificationQueue()
+{
+	NotificationQueue.Reset();
+}
+
+int32 UWindowSubsystem::GetQueuedNotificationCount() const
+{
+	return NotificationQueue.Num();
+}
+
+UModelRepositorySubsystem* UWindowSubsystem::GetModelRepository() const
+{
+	if(ModelRepositoryCache.IsValid())
+	{
+		return ModelRepositoryCache.Get();
+	}
+
+	//Game instance may not exist yet when the world subsystems are initialized
+	if(const auto GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr)
+	{
+		ModelRepositoryCache = GameInstance->GetSubsystem<UModelRepositorySubsystem>();
+		return ModelRepositoryCache.Get();
+	}
+
+	return nullptr;
+}
+
+UWorldModelRepositorySubsystem* UWindowSubsystem::GetWorldModelRepository() const
+{
+	if(WorldModelRepositoryCache.IsValid())
+	{
+		return WorldModelRepositoryCache.Get();
+	}
+
+	if(GetWorld())
+	{
+		WorldModelRepositoryCache = GetWorld()->GetSubsystem<UWorldModelRepositorySubsystem>();
+		return WorldModelRepositoryCache.Get();
+	}
+
+	return nullptr;
+}
+
+UUIView* UWindowSubsystem::CreateWindow(const TSubclassOf<UUIView>& WindowType, APlayerController* Owner) const
+{
+	MVVM_HITCH_SCOPE(ViewCreation, WindowType);
+
+	//Generated names: a prewarmed, discarded or just closed instance of the class may still be alive in the same outer.
+	//NAME_None does not build a name from a string either
+	if(IsValid(Owner))
+	{
+		return Cast<UUIView>(CreateWidget(Owner, WindowType, NAME_None));
+	}
+	else
+	{
+		return Cast<UUIView>(CreateWidget(GetWorld(), WindowType, NAME_None));
+	}
+}
+
+void UWindowSubsystem::AttachWindow(UUIView* Window)
+{
+	//Hidden after attaching, a Detached view can only leave the viewport once it is in it
+	Window->AddToViewport(static_cast<int32>(Window->GetUILayer()));
+	
+	if(bIsHiddenAllWindows)
+	{
+		Window->HideView();
+	}
+}
+
+void UWindowSubsystem::CommitWindowBatch()
+{
+	if(PendingWindowAttachments.IsEmpty()) return;
+
+	auto Attachments = MoveTemp(PendingWindowAttachments);
+	PendingWindowAttachments.Reset();
+
+	//Lower layers first, open order inside a layer
+	Algo::StableSortBy(Attachments, [](const FPendingWindowAttachment& Attachment)
+	{
+		return Attachment.Window ? static_cast<int32>(Attachment.Window->GetUILayer()) : 0;
+	});
+
+	for (const auto& Attachment : Attachments)
+	{
+		if(IsValid(Attachment.Window))
+		{
+			AttachWindow(Attachment.Window);
+		}
+	}
+
+	//Views are initialized after the whole set is attached, so viewmodels see every window of the batch
+	for (const auto& Attachment : Attachments)
+	{
+		if(IsValid(Attachment.Window))
+		{
+			InitializeExistsView(Attachment.Window);
+		}
+	}
+}
+
+void UWindowSubsystem::ProcessPrewarmHints()
+{
+	if(PendingPrewarmHints.IsEmpty()) return;
+
+	//Only frames with headroom are used, so prewarming never makes a slow frame slower
+	const auto Settings = GetDefault<UMVVMLibraryUISettings>();
+	if(FApp::GetDeltaTime() * 1000.0 > Settings->PrewarmIdleFrameTimeMs) return;
+
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	const double BudgetEndTime = FPlatformTime::Seconds() + Settings->PrewarmFrameBudgetMs / 1000.0;
+	do
+	{
+		const FWindowPrewarmHint Hint = PendingPrewarmHints[0];
+		PendingPrewarmHints.RemoveAt(0);
+
+		if(Hint.ExpirationTime > Now)
+		{
+			PrepareWindow(Hint);
+		}
+	}
+	while(!PendingPrewarmHints.IsEmpty() && FPlatformTime::Seconds() < BudgetEndTime);
+}
+
+void UWindowSubsystem::PrepareWindow(const FWindowPrewarmHint& Hint)
+{
+	UClass* WindowType = Hint.WindowType;
+	if(!IsValid(WindowType) || OpenedWindows.Contains(WindowType) || PrewarmedWindows.Contains(WindowType)) return;
+
+	const int32 MaxPrewarmedWindows = GetDefault<UMVVMLibraryUISettings>()->MaxPrewarmedWindows;
+	if(MaxPrewarmedWindows <= 0) return;
+
+	//Memory cap: the prepared window closest to expiry is the least valuable one
+	while(PrewarmedWindows.Num() >= MaxPrewarmedWindows)
+	{
+		UClass* EvictedType = nullptr;
+		double EvictedExpirationTime = TNumericLimits<double>::Max();
+		for (const auto& [PreparedType, Prepared] : PrewarmedWindows)
+		{
+			if(Prepared.ExpirationTime < EvictedExpirationTime)
+			{
+				EvictedType = PreparedType;
+				EvictedExpirationTime = Prepared.ExpirationTime;
+			}
+		}
+
+		if(EvictedExpirationTime > Hint.ExpirationTime) return;
+		PrewarmedWindows.Remove(EvictedType);
+	}
+
+	FPrewarmedWindow Prepared;
+	Prepared.Window = CreateWindow(Hint.WindowType, Hint.Owner.Get());
+	Prepared.ExpirationTime = Hint.ExpirationTime;
+	if(!Prepared.Window) return;
+
+	//Build the Slate tree offscreen, so attaching to the viewport later does not construct it
+	Prepared.SlateWidget = Prepared.Window->TakeWidget();
+	InitializeExistsView(Prepared.Window);
+
+	PrewarmedWindows.Add(WindowType, MoveTemp(Prepared));
+}
+
+void UWindowSubsystem::DiscardExpiredPrewarmedWindows()
+{
+	if(PrewarmedWindows.IsEmpty()) return;
+
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	for (auto It = PrewarmedWindows.CreateIterator(); It; ++It)
+	{
+		if(It->Value.ExpirationTime <= Now || !IsValid(It->Value.Window))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+UUIView* UWindowSubsystem::TakePrewarmedWindow(UClass* WindowType, APlayerController* Owner, TSharedPtr<SWidget>& OutSlateWidget)
+{
+	if(PrewarmedWindows.IsEmpty()) return nullptr;
+
+	FPrewarmedWindow Prepared;
+	if(!PrewarmedWindows.RemoveAndCopyValue(WindowType, Prepared) || !IsValid(Prepared.Window))
+	{
+		return nullptr;
+	}
+
+	//A window prepared for another player can not be reused
+	if(IsValid(Owner) && Prepared.Window->GetOwningPlayer() != Owner)
+	{
+		return nullptr;
+	}
+
+	OutSlateWidget = MoveTemp(Prepared.SlateWidget);
+	return Prepared.Window;
+}
+
+void UWindowSubsystem::OnPreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
+{
+	if(WorldContext.World() == GetWorld() && GetDefault<UMVVMLibraryUISettings>()->bRestoreWindowsAfterTravel)
+	{
+		CaptureWindowState();
+	}
+}
+
+void UWindowSubsystem::OnSeamlessTravelStart(UWorld* World, const FString& MapName)
+{
+	if(World == GetWorld() && GetDefault<UMVVMLibraryUISettings>()->bRestoreWindowsAfterTravel)
+	{
+		CaptureWindowState();
+	}
+}
+
+void UWindowSubsystem::ProcessWindowRestore()
+{
+	if(PendingRestoreWindows.IsEmpty()) return;
+
+	const auto Settings = GetDefault<UMVVMLibraryUISettings>();
+	const bool bIsOwnerWaitOver = GetWorld()->GetRealTimeSeconds() - RestoreStartTime > Settings->WindowRestoreOwnerTimeout;
+	const double BudgetEndTime = FPlatformTime::Seconds() + Settings->WindowRestoreFrameBudgetMs / 1000.0;
+
+	TArray<UUIView*> RestoredWindows;
+	TArray<FWindowDescriptor> RestoredDescriptors;
+	{
+		//Windows of this frame are attached and initialized together when the batch ends
+		FScopedWindowBatch WindowBatch(this);
+
+		int32 Index = 0;
+		while(Index < PendingRestoreWindows.Num())
+		{
+			if(!RestoredWindows.IsEmpty() && FPlatformTime::Seconds() >= BudgetEndTime) break;
+
+			const auto& Descriptor = PendingRestoreWindows[Index];
+			const auto Owner = FindLocalPlayerController(Descriptor.LocalPlayerIndex);
+			if(!Owner && Descriptor.LocalPlayerIndex != INDEX_NONE && !bIsOwnerWaitOver)
+			{
+				//The player controller of the new world may not be spawned yet
+				++Index;
+				continue;
+			}
+
+			if(const auto Window = OpenWindow(Descriptor.WindowType, Owner))
+			{
+				RestoredWindows.Add(Window);
+				RestoredDescriptors.Add(MoveTemp(PendingRestoreWindows[Index]));
+			}
+			PendingRestoreWindows.RemoveAt(Index);
+		}
+	}
+
+	for (int32 Index = 0; Index < RestoredWindows.Num(); ++Index)
+	{
+		const auto Window = RestoredWindows[Index];
+		auto& Descriptor = RestoredDescriptors[Index];
+		
+		if(Descriptor.bIsHidden)
+		{
+			Window->HideView();
+		}
+
+		if(!Descriptor.ViewModelState.IsEmpty())
+		{
+			Window->ApplyRestoreState(MoveTemp(Descriptor.ViewModelState));
+		}
+	}
+}
+
+APlayerController* UWindowSubsystem::FindLocalPlayerController(int32 LocalPlayerIndex) const
+{
+	if(LocalPlayerIndex == INDEX_NONE) return nullptr;
+
+	const auto GameInstance = GetWorld()->GetGameInstance();
+	const auto LocalPlayer = GameInstance ? GameInstance->GetLocalPlayerByIndex(LocalPlayerIndex) : nullptr;
+	return LocalPlayer ? LocalPlayer->GetPlayerController(GetWorld()) : nullptr;
+}
+
+UWindowStateSubsystem* UWindowSubsystem::GetWindowStateSubsystem() const
+{
+	const auto GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UWindowStateSubsystem>() : nullptr;
+}
+
+UUIViewModel* UWindowSubsystem::FindSharedViewModel(const UClass* ViewModelType, const UObject* Context) const
+{
+	const auto SharedViewModel = SharedViewModels.Find(MakeTuple(FObjectKey(ViewModelType), FObjectKey(Context)));
+	return SharedViewModel ? SharedViewModel->Get() : nullptr;
+}
+
+void UWindowSubsystem::RegisterSharedViewModel(UUIViewModel* ViewModel, const UObject* Context)
+{
+	check(ViewModel);
+	ViewModel->SharedContext = FObjectKey(Context);
+	SharedViewModels.Add(MakeTuple(FObjectKey(ViewModel->GetClass()), ViewModel->SharedContext), ViewModel);
+}
+
+void UWindowSubsystem::UnregisterSharedViewModel(UUIViewModel* ViewModel)
+{
+	check(ViewModel);
+	const auto Key = MakeTuple(FObjectKey(ViewModel->GetClass()), ViewModel->SharedContext);
+	if(const auto SharedViewModel = SharedViewModels.Find(Key); SharedViewModel && SharedViewModel->Get() == ViewModel)
+	{
+		SharedViewModels.Remove(Key);
+	}
+}
+
+UUIViewModel* UWindowSubsystem::TakePooledViewModel(UClass* ViewModelType)
+{
+	const auto Pool = ViewModelPools.Find(ViewModelType);
+	return Pool && !Pool->ViewModels.IsEmpty() ? Pool->ViewModels.Pop() : nullptr;
+}
+
+void UWindowSubsystem::ReturnViewModelToPool(UUIViewModel* ViewModel)
+{
+	check(ViewModel);
+	const int32 MaxPooledViewModels = GetDefault<UMVVMLibraryUISettings>()->MaxPooledViewModelsPerClass;
+
+	auto& Pool = ViewModelPools.FindOrAdd(ViewModel->GetClass());
+	if(Pool.ViewModels.Num() < MaxPooledViewModels)
+	{
+		Pool.ViewModels.Add(ViewModel);
+	}
+}
+
+void UWindowSubsystem::RegisterLODView(UUIView* View)
+{
+	check(View);
+	if(LODViews.ContainsByPredicate([View](const FLODViewEntry& Entry) { return Entry.View == View; })) return;
+
+	LODViews.AddDefaulted_GetRef().View = View;
+}
+
+void UWindowSubsystem::UnregisterLODView(UUIView* View)
+{
+	const int32 Index = LODViews.IndexOfByPredicate([View](const FLODViewEntry& Entry) { return Entry.View == View; });
+	if(Index != INDEX_NONE)
+	{
+		LODViews.RemoveAtSwap(Index);
+	}
+}
+
+void UWindowSubsystem::ProcessViewLOD(float DeltaTime)
+{
+	if(LODViews.IsEmpty()) return;
+
+	const auto Settings = GetDefault<UMVVMLibraryUISettings>();
+	const float DormantDistanceSquared = FMath::Square(Settings->ViewLODDormantDistance);
+
+	//Camera of each local player, resolved once per frame
+	struct FLODCamera
+	{
+		const APlayerController* PlayerController;
+		FVector Location;
+		float ScreenScale;
+	};
+	TArray<FLODCamera, TInlineAllocator<4>> Cameras;
+	const auto GetCamera = [this, &Cameras](const APlayerController* PlayerController) -> const FLODCamera*
+	{
+		if(!PlayerController) PlayerController = GetWorld()->GetFirstPlayerController();
+		if(!PlayerController || !PlayerController->PlayerCameraManager) return nullptr;
+
+		if(const auto Camera = Cameras.FindByPredicate([PlayerController](const FLODCamera& Camera) { return Camera.PlayerController == PlayerController; }))
+		{
+			return Camera;
+		}
+
+		auto& Camera = Cameras.AddDefaulted_GetRef();
+		Camera.PlayerController = PlayerController;
+		Camera.Location = PlayerController->PlayerCameraManager->GetCameraLocation();
+		//Screen size = radius / (distance * tan(FOV / 2)); the tangent is shared by all views of the camera
+		Camera.ScreenScale = 1.f / FMath::Max(FMath::Tan(FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f)), UE_KINDA_SMALL_NUMBER);
+		return &Camera;
+	};
+
+	for (int32 Index = LODViews.Num() - 1; Index >= 0; --Index)
+	{
+		const auto View = LODViews[Index].View.Get();
+		const auto Actor = View ? View->GetBoundActor() : nullptr;
+		if(!Actor)
+		{
+			LODViews.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const FLODCamera* Camera = GetCamera(View->GetOwningPlayer());
+		if(!Camera) continue;
+
+		EUIViewLOD NewLOD = EUIViewLOD::Dormant;
+		const float DistanceSquared = FVector::DistSquared(Camera->Location, Actor->GetActorLocation());
+		if(DistanceSquared <= DormantDistanceSquared)
+		{
+			const float ScreenSize = View->LODBoundsRadius * FMath::InvSqrt(FMath::Max(DistanceSquared, 1.f)) * Camera->ScreenScale;
+			//Render results of the last frames cover both frustum culling and occlusion
+			if(!Actor->WasRecentlyRendered(Settings->ViewLODRenderedTolerance) || ScreenSize < Settings->ViewLODReducedScreenSize)
+			{
+				NewLOD = EUIViewLOD::Low;
+			}
+			else
+			{
+				NewLOD = ScreenSize >= Settings->ViewLODFullScreenSize ? EUIViewLOD::Full : EUIViewLOD::Reduced;
+			}
+		}
+
+		const bool bWasDormant = View->GetViewLOD() == EUIViewLOD::Dormant;
+		View->SetViewLOD(NewLOD);
+		//Tier change events may bind or unbind views
+		if(!LODViews.IsValidIndex(Index) || LODViews[Index].View != View) continue;
+
+		auto& Entry = LODViews[Index];
+		if(NewLOD == EUIViewLOD::Dormant || !View->ViewModel)
+		{
+			Entry.TimeSinceUpdate = 0.f;
+			continue;
+		}
+
+		Entry.TimeSinceUpdate += DeltaTime;
+		float UpdateInterval = 0.f;
+		switch (NewLOD)
+		{
+		case EUIViewLOD::Reduced:	UpdateInterval = Settings->ViewLODReducedUpdateInterval; break;
+		case EUIViewLOD::Low:		UpdateInterval = Settings->ViewLODLowUpdateInterval; break;
+		default: break;
+		}
+
+		//A view waking up from dormancy is refreshed at once
+		if(bWasDormant || Entry.TimeSinceUpdate >= UpdateInterval)
+		{
+			const float UpdateDeltaTime = Entry.TimeSinceUpdate;
+			Entry.TimeSinceUpdate = 0.f;
+			View->ViewModel->UpdateViewModel(UpdateDeltaTime);
+		}
+	}
+}
+
+bool UWindowSubsystem::HasNotificationCapacity(UClass* PopUpType) const
+{
+	const int32 MaxConcurrent = GetDefault<UUIPopUpView>(PopUpType)->MaxConcurrentNotifications;
+	if(MaxConcurrent <= 0) return true;
+
+	const auto* ActiveCount = ActiveNotificationCounts.Find(FObjectKey(PopUpType));
+	return !ActiveCount || *ActiveCount < MaxConcurrent;
+}
+
+bool UWindowSubsystem::HasNotificationSpawnBudget()
+{
+	const int32 MaxSpawns = GetDefault<UMVVMLibraryUISettings>()->MaxNotificationSpawnsPerFrame;
+	if(MaxSpawns <= 0) return true;
+
+	if(NotificationSpawnFrame != GFrameCounter)
+	{
+		NotificationSpawnFrame = GFrameCounter;
+		NotificationSpawnsThisFrame = 0;
+	}
+
+	return NotificationSpawnsThisFrame < MaxSpawns;
+}
+
+void UWindowSubsystem::EnqueueNotification(FPendingNotification&& Notification)
+{
+	const int32 MaxQueued = FMath::Max(GetDefault<UMVVMLibraryUISettings>()->MaxQueuedNotifications, 1);
+	if(NotificationQueue.Num() >= MaxQueued)
+	{
+		//The queue is sorted, so its last notification has the lowest priority
+		if(NotificationQueue.Last().Priority >= Notification.Priority) return;
+		NotificationQueue.Pop();
+	}
+
+	const int32 Index = Algo::UpperBoundBy(NotificationQueue, MakeTuple(-Notification.Priority, Notification.Sequence),
+		[](const FPendingNotification& Queued)
+		{
+			return MakeTuple(-Queued.Priority, Queued.Sequence);
+		});
+	NotificationQueue.Insert(MoveTemp(Notification), Index);
+}
+
+UUIPopUpView* UWindowSubsystem::SpawnNotification(FPendingNotification& Notification)
+{
+	const auto PopUp = SpawnPopUp(Notification.PopUpType, Notification.Owner.Get(), Notification.ParentWidget.Get());
+	if(!PopUp) return nullptr;
+
+	++NotificationSpawnsThisFrame;
+
+	//Registered before initialization, so a pop-up removed by its own InitializePopUp is released correctly
+	const FObjectKey TypeKey(Notification.PopUpType);
+	PopUp->NotificationSubsystem = this;
+	PopUp->NotificationKey = Notification.Key;
+	PopUp->NotificationCount = Notification.Count;
+	++ActiveNotificationCounts.FindOrAdd(TypeKey);
+	if(!Notification.Key.IsNone())
+	{
+		ActiveNotifications.Add(MakeTuple(TypeKey, Notification.Key), PopUp);
+	}
+
+	PopUp->InitializePopUp(GetModelRepository(), GetWorldModelRepository());
+	PopUp->InitializeNotification(Notification.Key, Notification.Count, Notification.Payload);
+
+	return PopUp;
+}
+
+void UWindowSubsystem::ProcessNotificationQueue()
+{
+	for (int32 Index = 0; Index < NotificationQueue.Num() && HasNotificationSpawnBudget();)
+	{
+		const auto& Queued = NotificationQueue[Index];
+		
+		//A notification whose owner or parent widget is gone has nowhere to be shown
+		const bool bLostOwner = !Queued.Owner.IsExplicitlyNull() && !Queued.Owner.IsValid();
+		const bool bLostParent = !Queued.ParentWidget.IsExplicitlyNull() && !Queued.ParentWidget.IsValid();
+		if(!IsValid(Queued.PopUpType) || bLostOwner || bLostParent)
+		{
+			NotificationQueue.RemoveAt(Index);
+			continue;
+		}
+
+		//Classes at their limit keep their place, lower priority notifications of other classes may pass
+		if(!HasNotificationCapacity(Queued.PopUpType))
+		{
+			++Index;
+			continue;
+		}
+
+		auto Notification = MoveTemp(NotificationQueue[Index]);
+		NotificationQueue.RemoveAt(Index);
+		SpawnNotification(Notification);
+	}
+}
+
+void UWindowSubsystem::OnNotificationDestroyed(UUIPopUpView* PopUp)
+{
+	const FObjectKey TypeKey(PopUp->GetClass());
+	if(auto* ActiveCount = ActiveNotificationCounts.Find(TypeKey))
+	{
+		if(--*ActiveCount <= 0)
+		{
+			ActiveNotificationCounts.Remove(TypeKey);
+		}
+	}
+
+	if(!PopUp->NotificationKey.IsNone())
+	{
+		const auto Key = MakeTuple(TypeKey, PopUp->NotificationKey);
+		if(const auto* ActivePopUp = ActiveNotifications.Find(Key); ActivePopUp && ActivePopUp->Get() == PopUp)
+		{
+			ActiveNotifications.Remove(Key);
+		}
+	}
+}
+
+void UWindowSubsystem::SchedulePopUpLifeSpan(UUIPopUpView* PopUp, float Seconds)
+{
+	const double ExpireTime = GetWorld()->GetTimeSeconds() + FMath::Max(Seconds, 0.f);
+	if(!PopUpLifeSpans->Reschedule(PopUp->LifeSpanHandle, ExpireTime))
+	{
+		PopUp->LifeSpanHandle = PopUpLifeSpans->Schedule(PopUp, ExpireTime);
+	}
+}
+
+void UWindowSubsystem::CancelPopUpLifeSpan(FPopUpTimerHandle& Handle)
+{
+	PopUpLifeSpans->Cancel(Handle);
+}
+
+float UWindowSubsystem::GetPopUpRemainingLifeSpan(const FPopUpTimerHandle& Handle) const
+{
+	return static_cast<float>(PopUpLifeSpans->GetRemainingTime(Handle, GetWorld()->GetTimeSeconds()));
+}
+
+void UWindowSubsystem::ProcessPopUpLifeSpans()
+{
+	if(PopUpLifeSpans->Num() == 0) return;
+
+	PopUpLifeSpans->Advance(GetWorld()->GetTimeSeconds(), ExpiredPopUps);
+
+	//Single release point of expired pop-ups, so they can be handed to a widget pool instead of being destroyed
+	for (const auto& ExpiredPopUp : ExpiredPopUps)
+	{
+		if(const auto PopUp = ExpiredPopUp.Get())
+		{
+			PopUp->LifeSpanHandle.Invalidate();
+			PopUp->OnDestroyTimerComplete();
+		}
+	}
+	ExpiredPopUps.Reset();
+}
+
+void UWindowSubsystem::RegisterCoroutineOwner(UUIViewModel* ViewModel)
+{
+	CoroutineOwners.AddUnique(ViewModel);
+}
+
+void UWindowSubsystem::ProcessViewModelCoroutines()
+{
+	//Owners registered while resuming are appended and visited in this pass
+	for (int32 Index = 0; Index < CoroutineOwners.Num();)
+	{
+		const auto ViewModel = CoroutineOwners[Index].Get();
+		if(ViewModel && ViewModel->ResumeCoroutines())
+		{
+			++Index;
+		}
+		else
+		{
+			CoroutineOwners.RemoveAtSwap(Index);
+		}
+	}
+}
+
+TSharedRef<FDerivedViewDataQueue, ESPMode::ThreadSafe> UWindowSubsystem::RegisterDerivedViewData(
+	const TSharedRef<FDerivedViewDataChannel, ESPMode::ThreadSafe>& Channel)
+{
+	DerivedViewDataChannels.Add(Channel);
+	return DerivedViewDataResults.ToSharedRef();
+}
+
+void UWindowSubsystem::ProcessDerivedViewData()
+{
+	for (int32 Index = 0; Index < DerivedViewDataChannels.Num();)
+	{
+		const auto Channel = DerivedViewDataChannels[Index].Pin();
+		if(Channel.IsValid() && Channel->GetOwner())
+		{
+			Channel->PollInput();
+			++Index;
+		}
+		else
+		{
+			DerivedViewDataChannels.RemoveAtSwap(Index);
+		}
+	}
+
+	TArray<UUIViewModel*, TInlineAllocator<8>> ChangedViewModels;
+	FDerivedViewDataResult Result;
+	while(DerivedViewDataResults->Dequeue(Result))
+	{
+		//Stale when a newer request was made after the result was computed
+		const auto Owner = Result.Channel->GetOwner();
+		if(Owner && Result.Channel->IsCurrent(Result.Generation))
+		{
+			Result.Apply();
+			ChangedViewModels.AddUnique(Owner);
+		}
+	}
+	//Released here, not when the next result is dequeued
+	Result = FDerivedViewDataResult();
+
+	for (const auto ViewModel : ChangedViewModels)
+	{
+		ViewModel->NotifyViewChanged();
+	}
+}
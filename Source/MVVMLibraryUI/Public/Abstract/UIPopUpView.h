@@ -0,0 +1,180 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UIView.h"
+#include "PopUpTimingWheel.h"
+#include "UIPopUpView.generated.h"
+
+class UWindowSubsystem;
+/**
+ * 
+ */
+UCLASS(Abstract)
+class MVVMLIBRARYUI_API UUIPopUpView : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintAssignable)
+	FOnActionDelegate OnDestroyPopUp;
+
+protected:
+	
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MVVM|Pop-Up")
+	EUILayer ViewLayer = EUILayer::PopUp;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MVVM|Pop-Up")
+	bool bUseSelfDestroyTimer = false;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MVVM|Pop-Up")
+	float LifeSpan = 3.f;
+
+	/**
+	 * Maximum number of pop-ups of this class shown at once through PushNotification. Further notifications wait in the queue.
+	 * 0 == unlimited
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|Pop-Up|Notification", meta = (ClampMin = "0"))
+	int32 MaxConcurrentNotifications = 3;
+
+private:
+
+	/** Bit per K2 event that is implemented in Blueprint. Resolved on the first dispatch */
+	TOptional<uint32> ImplementedBlueprintEvents;
+
+	UPROPERTY()
+	bool bIsInitializedPopUp = false;
+
+	/** Set once OnDestroyPopUp is broadcasted */
+	UPROPERTY()
+	bool bIsDestroyedPopUp = false;
+
+	UPROPERTY()
+	TWeakObjectPtr<UModelRepositorySubsystem> ModelRepository;
+	UPROPERTY()
+	TWeakObjectPtr<UWorldModelRepositorySubsystem> WorldModelRepository;
+
+	/** Lifespan in the timing wheel of UWindowSubsystem */
+	FPopUpTimerHandle LifeSpanHandle;
+
+	/** Set when the pop-up was spawned by UWindowSubsystem::PushNotification */
+	UPROPERTY()
+	TWeakObjectPtr<UWindowSubsystem> NotificationSubsystem = nullptr;
+	UPROPERTY()
+	FName NotificationKey = NAME_None;
+	UPROPERTY()
+	int32 NotificationCount = 0;
+
+protected:
+
+	virtual void NativeDestruct() override;
+
+	/**
+	 * Should be overridden in C++ heirs
+	 * @param InModelRepository - store of Session Models
+	 * @param InWorldModelRepository - store of Contextual Models
+	 */
+	UFUNCTION()
+	virtual void InitializePopUp(UModelRepositorySubsystem* InModelRepository, UWorldModelRepositorySubsystem* InWorldModelRepository);
+
+	/**
+	 * Should be overridden in C++ heirs. Called after InitializePopUp for pop-ups spawned by PushNotification
+	 * @param Key - Coalescing key of the notification
+	 * @param Count - Number of notifications merged into this pop-up
+	 * @param Payload - Data of the latest notification
+	 */
+	UFUNCTION()
+	virtual void InitializeNotification(FName Key, int32 Count, UObject* Payload);
+
+	/**
+	 * Should be overridden in C++ heirs. Called when another notification with the same key arrives while the pop-up is shown,
+	 * instead of spawning a new pop-up. The self destroy timer is restarted
+	 * @param Count - Number of notifications merged into this pop-up, e.g. for a "x10" counter
+	 * @param Payload - Data of the latest notification
+	 */
+	UFUNCTION()
+	virtual void OnNotificationCoalesced(int32 Count, UObject* Payload);
+
+public:
+	
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	EUILayer GetUILayer() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	bool IsInitializedPopUp() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	bool IsPopUpDestroyed() const;
+
+	/**
+	 * Number of notifications merged into this pop-up. 0 for pop-ups created with CreatePopUp
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	int32 GetNotificationCount() const;
+
+	/**
+	 * Adds time to the self destroy timer, or starts it if the pop-up has none
+	 * @param Seconds Extra lifespan
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	void ExtendLifeSpan(float Seconds);
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	float GetRemainingLifeSpan() const;
+
+	/**
+	 * Removes the pop-up before its lifespan ends
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	void DismissPopUp();
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	UModelRepositorySubsystem* GetModelRepository() const;
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|Pop-Up")
+	UWorldModelRepositorySubsystem* GetWorldModelRepository() const;
+
+protected:
+
+	/**
+	 * Service method. Do not call from C++
+	 * @param InModelRepository 
+	 * @param InWorldModelRepository 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|Pop-Up", meta=(ForceAsFunction, DisplayName = "InitializePopUp", ScriptName = "InitializePopUp"))
+	void K2_InitializePopUp(UModelRepositorySubsystem* InModelRepository, UWorldModelRepositorySubsystem* InWorldModelRepository);
+
+	/**
+	 * Event called after InitializePopUp for pop-ups spawned by PushNotification.
+	 * Do not call this event yourself. For C++ heirs there is a virtual method without K2 prefix
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|Pop-Up", meta=(DisplayName = "InitializeNotification", ScriptName = "InitializeNotification"))
+	void K2_InitializeNotification(FName Key, int32 Count, UObject* Payload);
+
+	/**
+	 * Event called when a notification with the same key is merged into this pop-up.
+	 * Do not call this event yourself. For C++ heirs there is a virtual method without K2 prefix
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|Pop-Up", meta=(DisplayName = "OnNotificationCoalesced", ScriptName = "OnNotificationCoalesced"))
+	void K2_OnNotificationCoalesced(int32 Count, UObject* Payload);
+
+	friend class UWindowSubsystem;
+
+private:
+
+	UFUNCTION()
+	void OnDestroyTimerComplete();
+
+	/** Starts or restarts the self destroy timer */
+	void StartSelfDestroyTimer();
+
+	UWindowSubsystem* GetWindowSubsystem() const;
+
+	/**
+	 * Lets pure C++ heirs skip the ProcessEvent round-trip of K2 events that are not implemented in Blueprint.
+	 * @param Event Index of the event in its name table
+	 */
+	bool IsImplementedInBlueprint(uint32 Event);
+};
@@ -0,0 +1,259 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "UILayer.h"
+#include "UIView.generated.h"
+
+
+class UWorldModelRepositorySubsystem;
+class UModelRepositorySubsystem;
+class UWindowSubsystem;
+class UUIViewModel;
+class AActor;
+class SInvalidationPanel;
+
+/**
+ * Update tier of a view bound to an actor. Chosen by UWindowSubsystem from distance, screen size and visibility of the actor.
+ */
+UENUM(BlueprintType)
+enum class EUIViewLOD : uint8
+{
+	/** Viewmodel updates every frame */
+	Full,
+	Reduced,
+	Low,
+	/** Beyond the dormant distance: no updates, the view may be hidden */
+	Dormant,
+};
+
+/**
+ * How HideView hides a view. Only Collapsed changes the layout of the parent.
+ */
+UENUM(BlueprintType)
+enum class EUIViewHideMode : uint8
+{
+	/** Takes no space. The parent recomputes its layout on every toggle */
+	Collapsed,
+	/** Keeps its space, is not painted */
+	Hidden,
+	/** Keeps its space and visibility, painted fully transparent and not hit-testable */
+	ZeroOpacity,
+	/** Removed from the viewport, the Slate widget is kept alive and reattached on show. Views in a panel use Collapsed */
+	Detached,
+};
+
+/**
+ * How often the widgets of a view are repainted.
+ */
+UENUM(BlueprintType)
+enum class EUIViewVolatility : uint8
+{
+	/** Repainted like any other widget */
+	Default,
+	/** Wrapped in an invalidation panel: cached until a widget or the viewmodel invalidates it, see UUIViewModel::NotifyViewChanged */
+	Cached,
+	/** Repainted every frame, even inside a cached parent */
+	Volatile,
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnActionDelegate);
+
+/**
+ * In the paradigm, MVVM represents the base class for all widgets and windows.
+ * The heirs of this class should contain only the logic of displaying information.
+ * No business logic.
+ */
+UCLASS(Abstract)
+class MVVMLIBRARYUI_API UUIView : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+
+	UPROPERTY()
+	FOnActionDelegate OnDestroyView;
+
+	/**
+	 * Viewmodel class of the view. Soft, so loading a view class does not pull its viewmodel class into memory.
+	 * Preload it with a view preload group (UViewPreloadSubsystem) or it is streamed in asynchronously when the view is initialized.
+	 * Former ViewModelClassType, redirected in Config/DefaultMVVMLibrary.ini. Saved hard references load as soft ones.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MVVM|View")
+	TSoftClassPtr<UUIViewModel> ViewModelClass;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "MVVM|View")
+	EUILayer ViewLayer = EUILayer::GameplayView;
+
+	/**
+	 * Radius of the bound actor used for its screen size, see BindToActor
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|View|LOD", meta = (ClampMin = "0", Units = "cm"))
+	float LODBoundsRadius = 100.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|View|Visibility")
+	EUIViewHideMode HideMode = EUIViewHideMode::Collapsed;
+
+	/** Visibility set by ShowView */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|View|Visibility")
+	ESlateVisibility ShownVisibility = ESlateVisibility::HitTestInvisible;
+
+	/** Takes effect when the Slate widget of the view is built */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|View|Visibility")
+	EUIViewVolatility Volatility = EUIViewVolatility::Default;
+
+private:
+
+	UPROPERTY()
+	TObjectPtr<UUIViewModel> ViewModel = nullptr;
+
+	UPROPERTY()
+	bool bIsInitializedView = false;
+
+	/** Services of the view, kept while the viewmodel class is streaming in */
+	UPROPERTY()
+	TWeakObjectPtr<UModelRepositorySubsystem> PendingModelRepository = nullptr;
+	UPROPERTY()
+	TWeakObjectPtr<UWorldModelRepositorySubsystem> PendingWorldModelRepository = nullptr;
+	UPROPERTY()
+	TWeakObjectPtr<UWindowSubsystem> PendingWindowSubsystem = nullptr;
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> PendingViewModelData = nullptr;
+
+	UPROPERTY()
+	TWeakObjectPtr<AActor> BoundActor = nullptr;
+
+	UPROPERTY()
+	EUIViewLOD ViewLOD = EUIViewLOD::Full;
+
+	/** State restored after level travel, applied as soon as the viewmodel is created */
+	TArray<uint8> PendingRestoreState;
+
+	UPROPERTY()
+	bool bIsViewHidden = false;
+
+	/** Render opacity restored by ShowView after a ZeroOpacity hide */
+	UPROPERTY()
+	float ShownRenderOpacity = 1.f;
+
+	/** Keeps the view constructed while it is hidden in Detached mode */
+	TSharedPtr<SWidget> DetachedSlateWidget;
+
+	TSharedPtr<SInvalidationPanel> InvalidationPanel;
+
+protected:
+
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+	virtual void NativeDestruct() override;
+
+public:
+
+	virtual void RemoveFromParent() override;
+
+	/**
+	 * Per-view preload hook. Called on the class default object when the preload group of the view is loaded.
+	 * Base implementation adds the viewmodel class.
+	 * @param OutAssets Assets to load together with the view class
+	 */
+	virtual void CollectPreloadAssets(TArray<FSoftObjectPath>& OutAssets) const;
+
+public:
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	EUILayer GetUILayer() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	bool IsInitializedView() const;
+
+	/**
+	 * The viewmodel is created once its class is loaded. Until then the view is initialized but has no viewmodel.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	bool IsViewModelReady() const;
+
+	/**
+	 * Points the viewmodel at new data without creating a new viewmodel, e.g. from NativeOnListItemObjectSet of a list entry.
+	 * Data set before the viewmodel is created is assigned right after its creation.
+	 * A shared viewmodel holds one data item for all views attached to it, so the last assigned data wins.
+	 * @param Data Item to show
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	void SetViewModelData(UObject* Data);
+
+	/**
+	 * Anchors the view to an actor, e.g. a nameplate or a health bar. The update rate of its viewmodel then follows the LOD tier
+	 * of the actor, see UUIViewModel::UpdateViewModel.
+	 * @param Actor Actor the view shows. nullptr unbinds the view
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	void BindToActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	AActor* GetBoundActor() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	EUIViewLOD GetViewLOD() const;
+
+	/**
+	 * Was the view hidden by HideView or by its visibility
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	bool IsViewHidden() const;
+
+	/**
+	 * Repaints a Cached view on the next frame. No-op for other volatilities. Called for every attached view by UUIViewModel::NotifyViewChanged
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View")
+	void InvalidateView();
+
+
+protected:
+
+	/**
+	 * Service method. Do not call from C++
+	 * @param InModelRepository 
+	 * @param InWorldModelRepository 
+	 * @param InWindowSubsystem - window subsystem of the world the view lives in
+	 */
+	UFUNCTION()
+	void InitializeView(UModelRepositorySubsystem* InModelRepository, UWorldModelRepositorySubsystem* InWorldModelRepository, UWindowSubsystem* InWindowSubsystem);
+	
+	UFUNCTION(BlueprintNativeEvent, Category = "MVVM|View", meta=(ForceAsFunction))
+	void ShowView();
+	UFUNCTION(BlueprintNativeEvent, Category = "MVVM|View", meta=(ForceAsFunction))
+	void HideView();
+
+	/**
+	 * Context of a shared viewmodel: views with the same viewmodel class and context attach to one instance.
+	 * Base implementation returns the owning player, so split-screen players do not share.
+	 * @return Context object or nullptr for one instance per world
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, BlueprintCosmetic, Category = "MVVM|View", meta=(ForceAsFunction))
+	UObject* GetSharedViewModelContext() const;
+
+private:
+
+	void CreateViewModel(UClass* InViewModelClass, UModelRepositorySubsystem* InModelRepository, UWorldModelRepositorySubsystem* InWorldModelRepository, UWindowSubsystem* InWindowSubsystem);
+	void OnViewModelClassLoaded(UObject* LoadedClass);
+
+	/**
+	 * Applies state restored after level travel, or keeps it until the viewmodel is created.
+	 * @param State Blob written by UUIViewModel::SerializeRestoreState
+	 */
+	void ApplyRestoreState(TArray<uint8>&& State);
+
+	/** Assigns the data and restore state set before the viewmodel was ready */
+	void ApplyPendingViewModelState();
+
+	/** Called by UWindowSubsystem when the LOD pass moves the view to another tier */
+	void SetViewLOD(EUIViewLOD NewLOD);
+
+	friend class UWindowSubsystem;
+	friend class UUIViewModel;
+};
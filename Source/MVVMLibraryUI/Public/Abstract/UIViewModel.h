@@ -0,0 +1,342 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ObjectWithWorldContext.h"
+#include "Abstract/UIView.h"
+#include "ViewModelCoroutine.h"
+#include "UIViewModel.generated.h"
+
+class UWorldModelRepositorySubsystem;
+class UWindowSubsystem;
+class UModelRepositorySubsystem;
+class UUIView;
+class UUIContextualModel;
+
+/**
+ * In the MVVM paradigm, it represents a base class for creating a layer between widgets and data.
+ * The heirs of this class should contain logic that tracks changes in data in models,
+ * logic for responding to user input events from the view,
+ * and logic for calling data updates on the view.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class MVVMLIBRARYUI_API UUIViewModel : public UObjectWithWorldContext
+{
+	GENERATED_BODY()
+
+private:
+
+	/** Bit per K2 event that is implemented in Blueprint. Resolved on the first dispatch */
+	TOptional<uint32> ImplementedBlueprintEvents;
+
+	/** Views using the viewmodel in attach order. Only shared viewmodels have more than one */
+	UPROPERTY()
+	TArray<TWeakObjectPtr<UUIView>> AttachedViews;
+
+	/** Registry key of a shared viewmodel in UWindowSubsystem */
+	FObjectKey SharedContext;
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> AssignedData = nullptr;
+
+	UPROPERTY()
+	TWeakObjectPtr<UModelRepositorySubsystem> ModelRepository = nullptr;
+	UPROPERTY()
+	TWeakObjectPtr<UWorldModelRepositorySubsystem> WorldModelRepository = nullptr;
+
+	UPROPERTY()
+	TWeakObjectPtr<UWindowSubsystem> WindowSubsystem = nullptr;
+	UPROPERTY()
+	mutable TWeakObjectPtr<APlayerController> FallbackPlayerController = nullptr;
+
+	/** Suspended coroutines, resumed by UWindowSubsystem */
+	TArray<FViewModelCoroutine> Coroutines;
+
+	/** Coroutines at the front of Coroutines cancelled while they were resumed. Destroyed once resuming ends */
+	int32 NumCancelledCoroutines = 0;
+
+	bool bIsResumingCoroutines = false;
+
+protected:
+
+	/**
+	 * Views with the same viewmodel class and context (UUIView::GetSharedViewModelContext) attach to one instance,
+	 * so subscriptions and computations run once. The viewmodel is destroyed when the last view detaches.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|ViewModel")
+	bool bIsShared = false;
+
+	/**
+	 * The viewmodel goes back to a pool of UWindowSubsystem when its view is destroyed, and the next view of the same
+	 * viewmodel class reuses it. SetModelRepository / SetWorldModelRepository run once per instance, so subscriptions to
+	 * models made there survive reuse. InitializeViewModel / OnDestroyViewModel run per view, AssignData per data item
+	 * and ResetViewModel before the instance returns to the pool.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "MVVM|ViewModel")
+	bool bIsPoolable = false;
+	
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	UModelRepositorySubsystem* GetModelRepository() const;
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	UWorldModelRepositorySubsystem* GetWorldModelRepository() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	UWindowSubsystem* GetWindowSubsystem() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	APlayerController* GetOwningPlayer() const;
+
+	/**
+	 * Gives the view to which the viewmodel belongs. For a shared viewmodel it is the earliest attached view still alive
+	 * @return View
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	UUIView* GetOwnerView() const;
+
+	/**
+	 * Gives all views using the viewmodel
+	 * @return Views in attach order
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	TArray<UUIView*> GetAttachedViews() const;
+
+	/**
+	 * Repaints the attached views after the viewmodel changed data they show. Required for views with Cached volatility
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	void NotifyViewChanged();
+
+	/**
+	 * Gives a contextual model and keeps it from being evicted while this viewmodel lives.
+	 * References are released in OnDestroyViewModel.
+	 * @param ModelType Type of the model
+	 * @return Model
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected, DeterminesOutputType = "ModelType"), Category = "MVVM|ViewModel")
+	UUIContextualModel* UseContextualModel(UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIContextualModel> ModelType);
+
+	/**
+	 * C++ template variant of UseContextualModel method. Auto Cast to T type
+	 * @tparam T Inheritor of UUIContextualModel class
+	 */
+	template<class T>
+	T* UseContextualModel()
+	{
+		return Cast<T>(UseContextualModel(T::StaticClass()));
+	}
+	
+	/**
+	 * Starts a coroutine owned by the viewmodel. It runs until its first co_await right away, is resumed by the window
+	 * subsystem when its awaiter is ready and is cancelled in OnDestroyViewModel.
+	 * @param Coroutine Result of a function using co_await
+	 */
+	void StartCoroutine(FViewModelCoroutine&& Coroutine);
+
+	/**
+	 * Destroys all running coroutines with their locals. A coroutine cancelling itself runs on until its next co_await
+	 */
+	void CancelCoroutines();
+
+	bool HasRunningCoroutines() const;
+
+	/**
+	 * Event calling when UView delegate OnDestroyView is broadcasted. You can use an override to unsubscribe own delegate bindings.
+	 * Base implementation cancels running coroutines.
+	 */
+	UFUNCTION()
+	virtual void OnDestroyViewModel();
+	
+	/**
+	 * Should be overridden in C++ heirs
+	 * @param InModelRepository - store of Session Models
+	 */
+	UFUNCTION()
+	virtual void SetModelRepository(UModelRepositorySubsystem* InModelRepository);
+	
+	/**
+	 * Should be overridden in C++ heirs
+	 * @param InWorldModelRepository - store of Contextual Models
+	 */
+	UFUNCTION()
+	virtual void SetWorldModelRepository(UWorldModelRepositorySubsystem* InWorldModelRepository);
+
+	/**
+	 * Should be overridden in C++ heirs
+	 * @param View - Owning View
+	 */
+	UFUNCTION()
+	virtual void InitializeViewModel(UUIView* View);
+
+	/**
+	 * Called when another view attaches to a shared viewmodel. The first view goes through InitializeViewModel
+	 * @param View - Attached view
+	 */
+	UFUNCTION()
+	virtual void OnViewAttached(UUIView* View);
+
+	/**
+	 * Called when a view detaches from a shared viewmodel and other views remain. The last view goes through OnDestroyViewModel
+	 * @param View - Detached view
+	 */
+	UFUNCTION()
+	virtual void OnViewDetached(UUIView* View);
+
+	/**
+	 * Saves or loads the state that should survive level travel. Ar.IsLoading() tells the direction.
+	 * Loading is called after InitializeViewModel of the reopened view. Base implementation keeps no state.
+	 * @param Ar Archive with the state blob
+	 */
+	virtual void SerializeRestoreState(FArchive& Ar);
+
+	/**
+	 * Should be overridden in C++ heirs
+	 * @param Data - Item the view shows now, e.g. the list item of an entry widget
+	 */
+	UFUNCTION()
+	virtual void AssignData(UObject* Data);
+
+	/**
+	 * Should be overridden in C++ heirs. Clears per-view and per-data state before a pooled viewmodel is reused
+	 */
+	UFUNCTION()
+	virtual void ResetViewModel();
+
+	/**
+	 * Should be overridden in C++ heirs. Called for viewmodels of views bound to an actor (UUIView::BindToActor)
+	 * at the update interval of the LOD tier. Dormant views get no updates.
+	 * @param DeltaTime - Time since the previous update
+	 */
+	UFUNCTION()
+	virtual void UpdateViewModel(float DeltaTime);
+
+	/**
+	 * Should be overridden in C++ heirs
+	 * @param NewLOD - LOD tier of the owning view
+	 */
+	UFUNCTION()
+	virtual void OnViewLODChanged(EUIViewLOD NewLOD);
+
+	/**
+	 * Gives the item set by AssignData
+	 * @return Data
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta=(BlueprintProtected), Category = "MVVM|ViewModel")
+	UObject* GetAssignedData() const;
+
+protected:
+
+	/**
+	 * Event calling when UView delegate OnDestroyView is broadcasted. You can use an override to unsubscribe own delegate bindings.
+	 * Need calling parent version.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(ForceAsFunction, DisplayName = "OnDestroyViewModel", ScriptName = "OnDestroyViewModel"))
+	void K2_OnDestroyViewModel();
+	
+	/**
+	 * Sets the model repository. You can use an override to get the required dependencies.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param InModelRepository 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(ForceAsFunction, DisplayName = "SetModelRepository", ScriptName = "SetModelRepository"))
+	void K2_SetModelRepository(UModelRepositorySubsystem* InModelRepository);
+
+	/**
+	 * Sets the world model repository. You can use an override to get the required dependencies.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param InWorldModelRepository 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(ForceAsFunction, DisplayName = "SetWorldModelRepository", ScriptName = "SetWorldModelRepository"))
+	void K2_SetWorldModelRepository(UWorldModelRepositorySubsystem* InWorldModelRepository);
+
+	/**
+	 * Base implementation. Serves to cast a view reference to the desired type, subscriptions to view and model delegates.
+	 * Need calling parent version!
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param View 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(ForceAsFunction, DisplayName = "InitializeViewModel", ScriptName = "InitializeViewModel"))
+	void K2_InitializeViewModel(UUIView* View);
+
+	/**
+	 * Event called when another view attaches to a shared viewmodel.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param View 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(DisplayName = "OnViewAttached", ScriptName = "OnViewAttached"))
+	void K2_OnViewAttached(UUIView* View);
+
+	/**
+	 * Event called when a view detaches from a shared viewmodel and other views remain.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param View 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(DisplayName = "OnViewDetached", ScriptName = "OnViewDetached"))
+	void K2_OnViewDetached(UUIView* View);
+
+	/**
+	 * Event called when the view gets new data. Drop subscriptions to the previous item and bind to the new one.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param Data 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(ForceAsFunction, DisplayName = "AssignData", ScriptName = "AssignData"))
+	void K2_AssignData(UObject* Data);
+
+	/**
+	 * Event called before a pooled viewmodel returns to the pool.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(ForceAsFunction, DisplayName = "ResetViewModel", ScriptName = "ResetViewModel"))
+	void K2_ResetViewModel();
+
+	/**
+	 * Event called at the update interval of the LOD tier of an actor-bound view.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param DeltaTime 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(DisplayName = "UpdateViewModel", ScriptName = "UpdateViewModel"))
+	void K2_UpdateViewModel(float DeltaTime);
+
+	/**
+	 * Event called when the LOD tier of the owning view changes.
+	 * Do not call this event yourself. For C++ there is a virtual method without K2 prefix
+	 * @param NewLOD 
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "MVVM|ViewModel", meta=(DisplayName = "OnViewLODChanged", ScriptName = "OnViewLODChanged"))
+	void K2_OnViewLODChanged(EUIViewLOD NewLOD);
+
+private:
+
+	/**
+	 * Binds world-scoped services once at creation, so the accessors never look them up again.
+	 * @param InWindowSubsystem - window subsystem of the owning view's world
+	 */
+	void BindServices(UWindowSubsystem* InWindowSubsystem);
+
+	/** Adds a view to a shared viewmodel */
+	void AttachView(UUIView* View);
+
+	/** Removes a destroyed view. The last view destroys the viewmodel */
+	void DetachView(UUIView* View);
+
+	/**
+	 * Resumes the coroutines whose awaiters are ready and drops finished ones.
+	 * @return Are coroutines still running?
+	 */
+	bool ResumeCoroutines();
+	
+	friend class UUIView;
+	friend class UWindowSubsystem;
+
+private:
+
+	/**
+	 * Lets pure C++ heirs skip the ProcessEvent round-trip of K2 events that are not implemented in Blueprint.
+	 * @param Event Index of the event in its name table
+	 */
+	bool IsImplementedInBlueprint(uint32 Event);
+};
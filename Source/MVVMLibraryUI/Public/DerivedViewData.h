@@ -0,0 +1,266 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModelSnapshot.h"
+#include "Containers/Queue.h"
+#include "Tasks/Task.h"
+
+class UUIViewModel;
+class FDerivedViewDataChannel;
+
+/**
+ * Output of a transform waiting to be applied on the game thread.
+ */
+struct FDerivedViewDataResult
+{
+	TSharedPtr<FDerivedViewDataChannel, ESPMode::ThreadSafe> Channel;
+	uint64 Generation = 0;
+	TUniqueFunction<void()> Apply;
+};
+
+/**
+ * Results of every channel of a window subsystem. A class rather than an alias, so it can be forward declared.
+ */
+class FDerivedViewDataQueue : public TQueue<FDerivedViewDataResult, EQueueMode::Mpsc>
+{
+};
+
+/**
+ * Type-erased state of a TDerivedViewData, shared with the worker tasks running its transform.
+ * Registered in UWindowSubsystem, which polls watched snapshots and applies finished results once per frame.
+ */
+class MVVMLIBRARYUI_API FDerivedViewDataChannel : public TSharedFromThis<FDerivedViewDataChannel, ESPMode::ThreadSafe>
+{
+public:
+
+	virtual ~FDerivedViewDataChannel() = default;
+
+	/** Requests a transform when the watched snapshot has a new version. Game thread */
+	virtual void PollInput() = 0;
+
+	/** @return Is Generation the latest request. Any thread */
+	bool IsCurrent(uint64 Generation) const
+	{
+		return LatestGeneration.load(std::memory_order_acquire) == Generation;
+	}
+
+	/** @return Owner while the channel is bound. Game thread */
+	UUIViewModel* GetOwner() const;
+
+protected:
+
+	/** Registers the channel in the window subsystem of the owner. Once per channel, TDerivedViewData::Bind makes a new one. Game thread */
+	void Register(UUIViewModel* InOwner);
+
+	/** Drops in-flight results and stops polling. Keeps the queue, results pushed later are discarded as stale. Game thread */
+	void Unregister();
+
+	/** @return Generation of a new request, making every older one stale */
+	uint64 NextGeneration()
+	{
+		return LatestGeneration.fetch_add(1, std::memory_order_acq_rel) + 1;
+	}
+
+	/** Pushes a result from a worker. Dropped when the window subsystem is gone */
+	void Enqueue(uint64 Generation, TUniqueFunction<void()>&& Apply);
+
+	TWeakObjectPtr<UUIViewModel> Owner;
+
+	/**
+	 * Weak, so results left in the queue do not keep it alive through their channel.
+	 * Written once by Register, before any transform is launched, and only read afterwards, so workers pin it without a lock
+	 */
+	TWeakPtr<FDerivedViewDataQueue, ESPMode::ThreadSafe> Queue;
+
+	std::atomic<uint64> LatestGeneration = 0;
+};
+
+/**
+ * View-ready data derived from model state on worker tasks, e.g. a sorted and filtered inventory or aggregated stats.
+ * Declare it as a member of a viewmodel and bind a pure transform from an input snapshot to TOutput. Every request runs
+ * the transform on a task; finished results are applied on the game thread by UWindowSubsystem in one batch per frame,
+ * followed by one NotifyViewChanged per viewmodel. A result is discarded when a newer request was made meanwhile.
+ * The transform must not touch UObjects, only its input. Bind, Watch, Request and Reset are game thread only.
+ * @tparam TInput Immutable input, usually the state of a TModelSnapshot
+ * @tparam TOutput Data shown by the view
+ */
+template<typename TInput, typename TOutput>
+class TDerivedViewData
+{
+public:
+
+	using FInputPtr = TSharedPtr<const TInput, ESPMode::ThreadSafe>;
+	using FTransform = TFunction<TOutput(const TInput& Input)>;
+	using FApply = TFunction<void(TOutput&& Output)>;
+
+	TDerivedViewData() = default;
+
+	~TDerivedViewData()
+	{
+		Reset();
+	}
+
+	TDerivedViewData(const TDerivedViewData&) = delete;
+	TDerivedViewData& operator=(const TDerivedViewData&) = delete;
+
+	/**
+	 * @param Owner Viewmodel the results are applied to. Results are dropped once it is destroyed
+	 * @param Transform Pure function run on worker tasks
+	 * @param Apply Receives the latest result on the game thread
+	 */
+	void Bind(UUIViewModel* Owner, FTransform Transform, FApply Apply)
+	{
+		Reset();
+
+		Channel = MakeShared<FChannel, ESPMode::ThreadSafe>(MoveTemp(Transform), MoveTemp(Apply));
+		Channel->Bind(Owner);
+	}
+
+	/**
+	 * Requests a transform for every snapshot published to Reader, starting with the current one.
+	 */
+	void Watch(const typename TModelSnapshot<TInput>::FReader& Reader)
+	{
+		if(Channel.IsValid())
+		{
+			Channel->Watch(Reader);
+		}
+	}
+
+	/**
+	 * Runs the transform for Input. Results of earlier requests still running are discarded.
+	 */
+	void Request(FInputPtr Input)
+	{
+		if(Channel.IsValid())
+		{
+			Channel->Request(MoveTemp(Input));
+		}
+	}
+
+	void Request(TInput&& Input)
+	{
+		Request(MakeShared<const TInput, ESPMode::ThreadSafe>(MoveTemp(Input)));
+	}
+
+	/** Discards running requests without unbinding */
+	void Cancel()
+	{
+		if(Channel.IsValid())
+		{
+			Channel->Cancel();
+		}
+	}
+
+	/** Discards running requests and unbinds. Called on destruction */
+	void Reset()
+	{
+		if(Channel.IsValid())
+		{
+			Channel->Unbind();
+			Channel.Reset();
+		}
+	}
+
+	/** @return Is a requested result not applied yet */
+	bool IsPending() const
+	{
+		return Channel.IsValid() && Channel->IsPending();
+	}
+
+private:
+
+	class FChannel : public FDerivedViewDataChannel
+	{
+	public:
+
+		FChannel(FTransform&& InTransform, FApply&& InApply)
+			: Transform(MoveTemp(InTransform))
+			, Apply(MoveTemp(InApply))
+		{
+		}
+
+		void Bind(UUIViewModel* InOwner)
+		{
+			Register(InOwner);
+		}
+
+		void Unbind()
+		{
+			Reader = {};
+			Unregister();
+		}
+
+		void Watch(const typename TModelSnapshot<TInput>::FReader& InReader)
+		{
+			Reader = InReader;
+			WatchedVersion = 0;
+			PollInput();
+		}
+
+		virtual void PollInput() override
+		{
+			if(!Reader.IsValid()) return;
+
+			const uint32 Version = Reader.GetVersion();
+			if(Version != WatchedVersion)
+			{
+				WatchedVersion = Version;
+				Request(Reader.Get());
+			}
+		}
+
+		void Request(FInputPtr Input)
+		{
+			if(!Input.IsValid() || !Owner.IsValid()) return;
+
+			const uint64 Generation = NextGeneration();
+
+			UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[This = StaticCastSharedRef<FChannel>(AsShared()), Input = MoveTemp(Input), Generation]()
+				{
+					//Skipped when a newer request was made before the task started
+					if(!This->IsCurrent(Generation)) return;
+
+					TOutput Output = This->Transform(*Input);
+
+					if(!This->IsCurrent(Generation)) return;
+
+					This->Enqueue(Generation, [This, Output = MoveTemp(Output), Generation]() mutable
+					{
+						This->AppliedGeneration = Generation;
+						This->Apply(MoveTemp(Output));
+					});
+				});
+		}
+
+		void Cancel()
+		{
+			AppliedGeneration = NextGeneration();
+		}
+
+		bool IsPending() const
+		{
+			const uint64 Latest = LatestGeneration.load(std::memory_order_acquire);
+			return Latest > 0 && (!AppliedGeneration.IsSet() || AppliedGeneration.GetValue() != Latest);
+		}
+
+	private:
+
+		const FTransform Transform;
+		const FApply Apply;
+
+		typename TModelSnapshot<TInput>::FReader Reader;
+		uint32 WatchedVersion = 0;
+
+		/** Generation of the last applied result. Game thread */
+		TOptional<uint64> AppliedGeneration;
+	};
+
+	TSharedPtr<FChannel, ESPMode::ThreadSafe> Channel;
+};
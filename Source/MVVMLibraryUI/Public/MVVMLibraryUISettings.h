@@ -0,0 +1,153 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "MVVMLibraryUISettings.generated.h"
+
+/**
+ * Views loaded together, e.g. during the loading screen of a map.
+ */
+USTRUCT()
+struct FViewPreloadGroupSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Config, EditAnywhere, Category = "View Preload", meta = (MetaClass = "/Script/MVVMLibraryUI.UIView"))
+	TArray<FSoftClassPath> Views;
+
+	/**
+	 * Group is requested automatically before every map load, so it streams in behind the loading screen.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View Preload")
+	bool bPreloadOnMapLoad = false;
+};
+
+/**
+ * Project-wide settings of the UI module of the MVVM Library plugin: windows, views and pop-ups.
+ * Edited in Project Settings -> Plugins -> MVVM Library UI.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "MVVM Library UI"))
+class MVVMLIBRARYUI_API UMVVMLibraryUISettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	UMVVMLibraryUISettings();
+
+	/**
+	 * Maximum number of prewarmed windows kept alive at once. When the cap is reached, the window closest to expiry is discarded.
+	 * 0 disables prewarming.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Window Prewarming", meta = (ClampMin = "0"))
+	int32 MaxPrewarmedWindows = 4;
+
+	/**
+	 * Time per frame that may be spent on constructing prewarmed windows. At least one window is prepared per eligible frame.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Window Prewarming", meta = (ClampMin = "0", Units = "ms"))
+	float PrewarmFrameBudgetMs = 2.f;
+
+	/**
+	 * Prewarming runs only on frames shorter than this, so it never makes a slow frame slower.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Window Prewarming", meta = (ClampMin = "0", Units = "ms"))
+	float PrewarmIdleFrameTimeMs = 20.f;
+
+	/**
+	 * Captures the open-window set before level travel and restores it in the new world.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Window Restore")
+	bool bRestoreWindowsAfterTravel = false;
+
+	/**
+	 * Time per frame that may be spent on reopening windows after travel. At least one window is reopened per frame.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Window Restore", meta = (ClampMin = "0", Units = "ms"))
+	float WindowRestoreFrameBudgetMs = 4.f;
+
+	/**
+	 * How long a window owned by a local player waits for its player controller in the new world.
+	 * Afterwards it is opened without an owner.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Window Restore", meta = (ClampMin = "0", Units = "s"))
+	float WindowRestoreOwnerTimeout = 5.f;
+
+	/**
+	 * Idle instances kept per poolable viewmodel class. Viewmodels returned above the cap are left to garbage collection.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Viewmodel Pooling", meta = (ClampMin = "0"))
+	int32 MaxPooledViewModelsPerClass = 32;
+
+	/**
+	 * Bound actors farther from the camera are dormant: their views get no updates.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View LOD", meta = (ClampMin = "0", Units = "cm"))
+	float ViewLODDormantDistance = 10000.f;
+
+	/**
+	 * Minimum screen size (bounds radius relative to half the view height) of a bound actor for the Full tier.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View LOD", meta = (ClampMin = "0", ClampMax = "1"))
+	float ViewLODFullScreenSize = 0.05f;
+
+	/**
+	 * Minimum screen size of a bound actor for the Reduced tier. Smaller actors and actors not rendered recently get the Low tier.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View LOD", meta = (ClampMin = "0", ClampMax = "1"))
+	float ViewLODReducedScreenSize = 0.015f;
+
+	/**
+	 * Viewmodel update interval of the Reduced tier. The Full tier updates every frame.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View LOD", meta = (ClampMin = "0", Units = "s"))
+	float ViewLODReducedUpdateInterval = 0.1f;
+
+	/**
+	 * Viewmodel update interval of the Low tier.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View LOD", meta = (ClampMin = "0", Units = "s"))
+	float ViewLODLowUpdateInterval = 0.5f;
+
+	/**
+	 * An actor not rendered for longer is treated as offscreen or occluded.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View LOD", meta = (ClampMin = "0", Units = "s"))
+	float ViewLODRenderedTolerance = 0.2f;
+
+	/**
+	 * Dormant views are hidden with HideView and shown again when they wake up.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View LOD")
+	bool bHideDormantViews = true;
+
+	/**
+	 * Named groups of views. A group loads the view classes and everything their CollectPreloadAssets hook adds,
+	 * including the soft viewmodel classes.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "View Preload")
+	TMap<FName, FViewPreloadGroupSettings> ViewPreloadGroups;
+
+	/**
+	 * How many queued notifications may become pop-ups in one frame. 0 == unlimited
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Notifications", meta = (ClampMin = "0"))
+	int32 MaxNotificationSpawnsPerFrame = 2;
+
+	/**
+	 * Notifications waiting for a free slot. When the queue is full the lowest priority notification is dropped.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Notifications", meta = (ClampMin = "1"))
+	int32 MaxQueuedNotifications = 64;
+
+	/**
+	 * Tick of the timing wheel that expires pop-up lifespans. A lifespan ends on the first tick at or after its expiry.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Notifications", meta = (ClampMin = "0.001", Units = "s"))
+	float PopUpLifeSpanResolution = 0.05f;
+};
@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UUIPopUpView;
+
+/**
+ * Handle of a lifespan scheduled in FPopUpTimingWheel. Becomes stale when the lifespan expires or is cancelled.
+ */
+struct FPopUpTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { Index = INDEX_NONE; }
+};
+
+/**
+ * Hashed timing wheel for pop-up lifespans. Time is split into ticks of a fixed resolution and every lifespan
+ * is linked into the slot of its expiry tick, so scheduling, extension and cancellation are O(1) and advancing
+ * only visits the slots that elapsed. Lifespans longer than one revolution stay in their slot until their tick comes.
+ * Not reflected, so GC never scans it. Game thread only.
+ */
+class MVVMLIBRARYUI_API FPopUpTimingWheel
+{
+public:
+
+	static constexpr int32 NumSlots = 512;
+
+	FPopUpTimingWheel() = default;
+
+	UE_NONCOPYABLE(FPopUpTimingWheel);
+
+	/**
+	 * Drops every lifespan and restarts the wheel.
+	 * @param InStartTime Current time
+	 * @param InResolution Duration of one tick in seconds
+	 */
+	void Reset(double InStartTime, double InResolution);
+
+	/**
+	 * @param PopUp Pop-up handed back on expiry
+	 * @param ExpireTime Time of expiry. Rounded up to the next tick
+	 * @return Handle of the lifespan
+	 */
+	FPopUpTimerHandle Schedule(UUIPopUpView* PopUp, double ExpireTime);
+
+	/**
+	 * Moves the expiry of a scheduled lifespan.
+	 * @return false if the handle is stale
+	 */
+	bool Reschedule(const FPopUpTimerHandle& Handle, double ExpireTime);
+
+	/** Removes the lifespan and invalidates the handle */
+	void Cancel(FPopUpTimerHandle& Handle);
+
+	bool IsScheduled(const FPopUpTimerHandle& Handle) const;
+
+	/** @return Seconds left or 0 if the handle is stale */
+	double GetRemainingTime(const FPopUpTimerHandle& Handle, double Now) const;
+
+	/**
+	 * Visits the slots elapsed since the previous call and removes their expired lifespans.
+	 * @param Now Current time
+	 * @param OutExpired Receives the expired pop-ups. Not emptied
+	 */
+	void Advance(double Now, TArray<TWeakObjectPtr<UUIPopUpView>>& OutExpired);
+
+	int32 Num() const { return NumScheduled; }
+
+private:
+
+	struct FEntry
+	{
+		TWeakObjectPtr<UUIPopUpView> PopUp;
+		int64 ExpiryTick = 0;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		uint32 Serial = 0;
+		bool bScheduled = false;
+	};
+
+	int64 ToTick(double Time) const;
+	void Link(int32 Index);
+	void Unlink(int32 Index);
+	void Release(int32 Index);
+
+	double StartTime = 0.0;
+	double Resolution = 0.05;
+
+	/** Last tick whose slot was visited */
+	int64 CurrentTick = 0;
+
+	/** First entry of every slot, INDEX_NONE when empty */
+	int32 SlotHeads[NumSlots];
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+	int32 NumScheduled = 0;
+	uint32 NextSerial = 1;
+
+	bool bIsReset = false;
+};
@@ -0,0 +1,18 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UILayer.generated.h"
+
+UENUM(BlueprintType)
+enum class EUILayer : uint8
+{
+	BehindHUD			UMETA(DisplayName = "Behind HUD"),
+	HUD					UMETA(DisplayName = "HUD"),
+	GameplayView		UMETA(DisplayName = "Gameplay View"),
+	PopUp,
+};
@@ -0,0 +1,213 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <coroutine>
+
+class UUIView;
+class UUIPopUpView;
+class UWindowSubsystem;
+struct FViewModelAwaiter;
+
+/**
+ * Coroutine owned by a UUIViewModel, e.g. "open a confirm pop-up, wait for it, wait for the model, close the window"
+ * written as one function instead of a chain of delegates. Return it from a function that uses co_await and pass it to
+ * UUIViewModel::StartCoroutine. The coroutine runs until its first co_await right away, is then resumed by
+ * UWindowSubsystem once per frame when its awaiter is ready, and is destroyed with its locals in OnDestroyViewModel.
+ * Awaiters are polled and live in the coroutine frame, so waiting allocates nothing.
+ * Game thread only.
+ */
+class MVVMLIBRARYUI_API FViewModelCoroutine
+{
+public:
+
+	struct promise_type
+	{
+		/** Awaiter the coroutine is suspended on, nullptr before the first resume */
+		FViewModelAwaiter* Awaiter = nullptr;
+
+		FViewModelCoroutine get_return_object()
+		{
+			return FViewModelCoroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { checkNoEntry(); }
+	};
+
+	using FHandle = std::coroutine_handle<promise_type>;
+
+	FViewModelCoroutine() = default;
+	~FViewModelCoroutine();
+
+	FViewModelCoroutine(FViewModelCoroutine&& Other)
+		: Handle(Other.Handle)
+	{
+		Other.Handle = nullptr;
+	}
+
+	FViewModelCoroutine& operator=(FViewModelCoroutine&& Other);
+
+	FViewModelCoroutine(const FViewModelCoroutine&) = delete;
+	FViewModelCoroutine& operator=(const FViewModelCoroutine&) = delete;
+
+	/**
+	 * Resumes the coroutine when its awaiter is ready.
+	 * @return Is the coroutine finished?
+	 */
+	bool Resume();
+
+	bool IsDone() const;
+
+private:
+
+	explicit FViewModelCoroutine(FHandle InHandle)
+		: Handle(InHandle)
+	{
+	}
+
+	FHandle Handle = nullptr;
+};
+
+/**
+ * Base of everything a viewmodel coroutine can co_await. Heirs implement IsReady and may hide await_resume to return a value.
+ */
+struct MVVMLIBRARYUI_API FViewModelAwaiter
+{
+	virtual ~FViewModelAwaiter() = default;
+
+	/** @return Can the coroutine resume. Polled once per frame while it waits */
+	virtual bool IsReady() const = 0;
+
+	bool await_ready() const { return IsReady(); }
+	void await_suspend(FViewModelCoroutine::FHandle Handle) { Handle.promise().Awaiter = this; }
+	void await_resume() const {}
+};
+
+/**
+ * Resumes in the next frame.
+ */
+struct MVVMLIBRARYUI_API FWaitNextFrame : FViewModelAwaiter
+{
+	FWaitNextFrame();
+
+	virtual bool IsReady() const override;
+
+private:
+
+	uint64 StartFrame;
+};
+
+/**
+ * Resumes after the game time of the world advanced by Seconds. Pauses with the world.
+ */
+struct MVVMLIBRARYUI_API FWaitSeconds : FViewModelAwaiter
+{
+	FWaitSeconds(const UObject* WorldContext, float Seconds);
+
+	virtual bool IsReady() const override;
+
+private:
+
+	TWeakObjectPtr<UWorld> World;
+	double ResumeTime = 0.0;
+};
+
+/**
+ * Resumes once the viewmodel of a window opened by OpenWindow is created. Returns the window or nullptr when it was destroyed.
+ */
+struct MVVMLIBRARYUI_API FWaitForWindowReady : FViewModelAwaiter
+{
+	explicit FWaitForWindowReady(UUIView* InWindow);
+
+	virtual bool IsReady() const override;
+	UUIView* await_resume() const;
+
+private:
+
+	TWeakObjectPtr<UUIView> Window;
+};
+
+/**
+ * Resumes once a window is closed or destroyed.
+ */
+struct MVVMLIBRARYUI_API FWaitForWindowClosed : FViewModelAwaiter
+{
+	explicit FWaitForWindowClosed(UUIView* InWindow);
+
+	virtual bool IsReady() const override;
+
+private:
+
+	TWeakObjectPtr<UUIView> Window;
+	TWeakObjectPtr<UWindowSubsystem> WindowSubsystem;
+};
+
+/**
+ * Resumes once a pop-up is destroyed, right after its OnDestroyPopUp.
+ */
+struct MVVMLIBRARYUI_API FWaitForPopUpDestroyed : FViewModelAwaiter
+{
+	explicit FWaitForPopUpDestroyed(UUIPopUpView* InPopUp);
+
+	virtual bool IsReady() const override;
+
+private:
+
+	TWeakObjectPtr<UUIPopUpView> PopUp;
+};
+
+/**
+ * Resumes once Predicate returns true.
+ */
+template<typename TPredicate>
+struct TWaitUntil : FViewModelAwaiter
+{
+	explicit TWaitUntil(TPredicate InPredicate)
+		: Predicate(MoveTemp(InPredicate))
+	{
+	}
+
+	virtual bool IsReady() const override
+	{
+		return Predicate();
+	}
+
+private:
+
+	TPredicate Predicate;
+};
+
+/**
+ * Resumes once a model is ready by Predicate(Model), e.g. done saving. Returns the model or nullptr when it was destroyed.
+ */
+template<typename TModel, typename TPredicate>
+struct TWaitForModel : FViewModelAwaiter
+{
+	TWaitForModel(TModel* InModel, TPredicate InPredicate)
+		: Model(InModel)
+		, Predicate(MoveTemp(InPredicate))
+	{
+	}
+
+	virtual bool IsReady() const override
+	{
+		return !Model.IsValid() || Predicate(Model.Get());
+	}
+
+	TModel* await_resume() const
+	{
+		return Model.Get();
+	}
+
+private:
+
+	TWeakObjectPtr<TModel> Model;
+	TPredicate Predicate;
+};
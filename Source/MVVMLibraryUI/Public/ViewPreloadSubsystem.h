@@ -0,0 +1,71 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ViewPreloadSubsystem.generated.h"
+
+struct FWorldContext;
+
+/**
+ * Loads the view preload groups from the plugin settings and keeps them in memory until released.
+ * Loading is asynchronous: a view of a group that is still streaming creates its viewmodel once the class arrives.
+ * Life cycle is all runtime
+ */
+UCLASS(NotBlueprintable, BlueprintType)
+class MVVMLIBRARYUI_API UViewPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+private:
+
+	struct FPreloadGroupHandles
+	{
+		/** View classes of the group */
+		TSharedPtr<FStreamableHandle> ViewsHandle;
+		/** Assets added by CollectPreloadAssets of the loaded views */
+		TSharedPtr<FStreamableHandle> AssetsHandle;
+		bool bIsLoaded = false;
+	};
+
+	FStreamableManager StreamableManager;
+	TMap<FName, FPreloadGroupHandles> PreloadGroups;
+	FDelegateHandle PreLoadMapHandle;
+
+public:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Starts loading a group. Does nothing if the group is loading or loaded.
+	 * @param GroupName Key in ViewPreloadGroups of the plugin settings
+	 * @return Is the group known?
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|ViewPreload")
+	bool PreloadGroup(FName GroupName);
+
+	/**
+	 * Releases the handles of a group, cancelling loads still in flight. Assets are unloaded by the next garbage collection
+	 * unless referenced elsewhere.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|ViewPreload")
+	void ReleasePreloadGroup(FName GroupName);
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|ViewPreload")
+	bool IsPreloadGroupLoaded(FName GroupName) const;
+
+private:
+
+	void OnPreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
+	void OnGroupViewsLoaded(FName GroupName);
+
+	/** Releases a finished handle, cancels an unfinished one */
+	static void ReleaseHandle(const TSharedPtr<FStreamableHandle>& Handle);
+};
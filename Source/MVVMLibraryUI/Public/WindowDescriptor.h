@@ -0,0 +1,37 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UILayer.h"
+#include "WindowDescriptor.generated.h"
+
+class UUIView;
+
+/**
+ * Compact description of one open window, enough to open it again in another world.
+ */
+USTRUCT()
+struct FWindowDescriptor
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<UUIView> WindowType = nullptr;
+	UPROPERTY()
+	EUILayer Layer = EUILayer::GameplayView;
+
+	/** Index of the owning local player. INDEX_NONE == Owner is WindowService */
+	UPROPERTY()
+	int32 LocalPlayerIndex = INDEX_NONE;
+
+	UPROPERTY()
+	bool bIsHidden = false;
+
+	/** Written by UUIViewModel::SerializeRestoreState */
+	UPROPERTY()
+	TArray<uint8> ViewModelState;
+};
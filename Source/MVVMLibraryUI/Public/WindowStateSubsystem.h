@@ -0,0 +1,64 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abstract/UIView.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "WindowDescriptor.h"
+#include "WindowStateSubsystem.generated.h"
+
+/**
+ * Set of windows that were open when a world was torn down.
+ */
+USTRUCT()
+struct FWindowSetSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FWindowDescriptor> Windows;
+
+	UPROPERTY()
+	bool bIsHiddenAllWindows = false;
+};
+
+/**
+ * Keeps the open-window set of the previous world across level travel. Life cycle is all runtime
+ */
+UCLASS(NotBlueprintable, BlueprintType)
+class MVVMLIBRARYUI_API UWindowStateSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+private:
+
+	UPROPERTY()
+	FWindowSetSnapshot StoredSnapshot;
+
+	UPROPERTY()
+	bool bHasStoredSnapshot = false;
+
+public:
+
+	/**
+	 * Stores a snapshot, replacing the previous one.
+	 * @param Snapshot Captured window set
+	 */
+	void StoreSnapshot(FWindowSetSnapshot&& Snapshot);
+
+	/**
+	 * Gives the stored snapshot away. The storage is empty afterwards.
+	 * @param OutSnapshot Stored window set
+	 * @return Was there a stored snapshot?
+	 */
+	bool TakeSnapshot(FWindowSetSnapshot& OutSnapshot);
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowState")
+	bool HasStoredSnapshot() const;
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowState")
+	void ClearStoredSnapshot();
+};
@@ -0,0 +1,520 @@
+/*
+* Copyright (c) 2025 Alexsander Khrapin
+* Licensed under the MIT License. See LICENSE in the project root for license information.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/PimplPtr.h"
+#include "UObject/ObjectKey.h"
+#include "WindowDescriptor.h"
+#include "WindowSubsystem.generated.h"
+
+class SWidget;
+struct FWorldContext;
+class UUIPopUpView;
+class UWorldModelRepositorySubsystem;
+class APlayerController;
+class UModelRepositorySubsystem;
+class UUIView;
+class UUIViewModel;
+class UPanelWidget;
+class UWindowStateSubsystem;
+class FPopUpTimingWheel;
+struct FPopUpTimerHandle;
+class FDerivedViewDataChannel;
+class FDerivedViewDataQueue;
+
+/**
+ * Request to prepare a window before it is opened.
+ */
+USTRUCT()
+struct FWindowPrewarmHint
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<UUIView> WindowType = nullptr;
+	UPROPERTY()
+	TWeakObjectPtr<APlayerController> Owner = nullptr;
+
+	/** World real time after which the hint is no longer worth fulfilling */
+	double ExpirationTime = 0.0;
+};
+
+/**
+ * Window that is constructed and initialized but not attached to the viewport yet.
+ */
+USTRUCT()
+struct FPrewarmedWindow
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UUIView> Window = nullptr;
+
+	/** Keeps the prebuilt Slate widget alive. Releasing it destructs the window and its viewmodel */
+	TSharedPtr<SWidget> SlateWidget;
+
+	/** World real time after which the prepared window is discarded */
+	double ExpirationTime = 0.0;
+};
+
+/**
+ * Window opened inside a window batch. It is attached and initialized when the batch is committed.
+ */
+USTRUCT()
+struct FPendingWindowAttachment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UUIView> Window = nullptr;
+
+	/** Prebuilt Slate widget of a prewarmed window. Keeps it alive until the window is attached */
+	TSharedPtr<SWidget> SlateWidget;
+};
+
+/**
+ * View bound to an actor, evaluated by the LOD pass.
+ */
+struct FLODViewEntry
+{
+	TWeakObjectPtr<UUIView> View;
+	float TimeSinceUpdate = 0.f;
+};
+
+/**
+ * Idle instances of one poolable viewmodel class.
+ */
+USTRUCT()
+struct FViewModelPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UUIViewModel>> ViewModels;
+};
+
+/**
+ * Notification waiting for a free pop-up slot or for the spawn budget of the next frame.
+ */
+USTRUCT()
+struct FPendingNotification
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<UUIPopUpView> PopUpType = nullptr;
+	UPROPERTY()
+	TWeakObjectPtr<APlayerController> Owner = nullptr;
+	UPROPERTY()
+	TWeakObjectPtr<UPanelWidget> ParentWidget = nullptr;
+	UPROPERTY()
+	TObjectPtr<UObject> Payload = nullptr;
+
+	FName Key = NAME_None;
+	int32 Priority = 0;
+
+	/** Number of notifications merged into this one */
+	int32 Count = 1;
+
+	/** Keeps the push order among notifications of equal priority */
+	uint64 Sequence = 0;
+};
+
+/**
+ * Serves for spawning, storing and closing windows. Life cycle is one scene
+ */
+UCLASS(NotBlueprintable, BlueprintType)
+class MVVMLIBRARYUI_API UWindowSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+
+	UPROPERTY()
+	TMap<UClass*, UUIView*> OpenedWindows;
+
+	UPROPERTY(BlueprintReadOnly, Category = "MVVM|WindowSubsystem", meta=(AllowPrivateAccess))
+	bool bIsHiddenAllWindows = false;
+
+	UPROPERTY()
+	mutable TWeakObjectPtr<UModelRepositorySubsystem> ModelRepositoryCache = nullptr;
+	UPROPERTY()
+	mutable TWeakObjectPtr<UWorldModelRepositorySubsystem> WorldModelRepositoryCache = nullptr;
+
+	/** Prewarm hints waiting for an idle frame, sorted by expiration time */
+	UPROPERTY()
+	TArray<FWindowPrewarmHint> PendingPrewarmHints;
+
+	UPROPERTY()
+	TMap<UClass*, FPrewarmedWindow> PrewarmedWindows;
+
+	/** Windows opened inside the current batch, in open order */
+	UPROPERTY()
+	TArray<FPendingWindowAttachment> PendingWindowAttachments;
+
+	int32 WindowBatchDepth = 0;
+
+	/** Windows of the previous world waiting to be reopened, ordered by layer */
+	UPROPERTY()
+	TArray<FWindowDescriptor> PendingRestoreWindows;
+
+	double RestoreStartTime = 0.0;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle SeamlessTravelStartHandle;
+
+	/** Views bound to actors, dense for the batched LOD pass */
+	TArray<FLODViewEntry> LODViews;
+
+	/** Idle poolable viewmodels by class */
+	UPROPERTY()
+	TMap<UClass*, FViewModelPool> ViewModelPools;
+
+	/** Shared viewmodels by class and context. Kept alive by their attached views */
+	TMap<TPair<FObjectKey, FObjectKey>, TWeakObjectPtr<UUIViewModel>> SharedViewModels;
+
+	/** Notifications waiting to be shown, sorted by priority, then by push order */
+	UPROPERTY()
+	TArray<FPendingNotification> NotificationQueue;
+
+	/** Shown notification pop-ups by class and coalescing key */
+	TMap<TPair<FObjectKey, FName>, TWeakObjectPtr<UUIPopUpView>> ActiveNotifications;
+
+	/** Shown notification pop-ups per class */
+	TMap<FObjectKey, int32> ActiveNotificationCounts;
+
+	/** Lifespans of all pop-ups with a self destroy timer. Created by the constructor */
+	TPimplPtr<FPopUpTimingWheel> PopUpLifeSpans;
+
+	/** Pop-ups expired in the current frame. Kept to reuse its allocation */
+	TArray<TWeakObjectPtr<UUIPopUpView>> ExpiredPopUps;
+
+	/** Viewmodels with running coroutines */
+	TArray<TWeakObjectPtr<UUIViewModel>> CoroutineOwners;
+
+	/** Derived data of viewmodels. Polled for new input snapshots */
+	TArray<TWeakPtr<FDerivedViewDataChannel, ESPMode::ThreadSafe>> DerivedViewDataChannels;
+
+	/** Results of derived data transforms, filled by worker tasks. Created by the constructor */
+	TSharedPtr<FDerivedViewDataQueue, ESPMode::ThreadSafe> DerivedViewDataResults;
+
+	uint64 NextNotificationSequence = 0;
+	uint64 NotificationSpawnFrame = 0;
+	int32 NotificationSpawnsThisFrame = 0;
+
+protected:
+
+	/**
+	 * Blueprint variant of OpenWindow method
+	 * @param WindowType Selected window type
+	 * @param Owner if nullptr == Owner is WindowService
+	 * @param bResult Is Successful?
+	 * @param OutWindow Opened Window
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, DisplayName = "OpenWindow", Category = "MVVM|WindowSubsystem", meta=(DeterminesOutputType = "WindowType", DynamicOutputParam = "OutWindow", ExpandBoolAsExecs="bResult"))
+	void K2_OpenWindow(UUIView*& OutWindow, bool& bResult, UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIView> WindowType, APlayerController* Owner = nullptr);
+
+	/**
+	 * Blueprint variant of OpenWindow method
+	 * @param PopUpType Selected Pop-Up type
+	 * @param Owner if nullptr == Owner is WindowService
+	 * @param ParentWidget Content Widget
+	 * @param bResult Is Successful?
+	 * @param OutPopUp Created Pop-up
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, DisplayName = "CreatePopUp", Category = "MVVM|WindowSubsystem", meta=(DeterminesOutputType = "PopUpType", DynamicOutputParam = "OutPopUp", ExpandBoolAsExecs="bResult"))
+	void K2_CreatePopUp(UUIPopUpView*& OutPopUp, bool& bResult, UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIPopUpView> PopUpType, APlayerController* Owner = nullptr, UPanelWidget* ParentWidget = nullptr);
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+
+	UWindowSubsystem();
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * C++ variant of OpenWindow method
+	 * @param WindowType Selected window type
+	 * @param Owner - nullptr == Owner is WindowService
+	 * @return Needed Window
+	 */
+	UFUNCTION()
+	UUIView* OpenWindow(TSubclassOf<UUIView> WindowType, APlayerController* Owner = nullptr);
+
+	/**
+	 * C++ template variant of OpenWindow method. Auto Cast to T type
+	 * @tparam T Inheritor of UUIView class
+	 * @param Owner nullptr == Owner is WindowService
+	 * @return Needed Pop-up widget
+	 */
+	template<class T = UUIView>
+	T* OpenWindow(TSubclassOf<UUIView> WindowType, APlayerController* Owner = nullptr)
+	{
+		static_assert(TIsDerivedFrom<T, UUIView>::IsDerived, "OpenWindow can only be used to create UUIView instances");
+		
+		check(IsValid(WindowType) && (WindowType->IsChildOf(T::StaticClass()) || WindowType == T::StaticClass()));
+		return Cast<T>(OpenWindow(MoveTemp(WindowType), Owner));
+	}
+	
+	/**
+	 * Opens several windows in one batch: viewport attachment, layer ordering and view initialization are committed together.
+	 * @param WindowTypes Selected window types
+	 * @param Owner nullptr == Owner is WindowService
+	 * @return Opened windows, in the order of WindowTypes. Invalid types are skipped
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	TArray<UUIView*> OpenWindows(const TArray<TSubclassOf<UUIView>>& WindowTypes, APlayerController* Owner = nullptr);
+	
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	bool CloseWindow(TSubclassOf<UUIView> WindowType);
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void CloseWindows(const TArray<TSubclassOf<UUIView>>& WindowTypes);
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void CloseAllWindows();
+
+	/**
+	 * Starts a window batch. Windows opened until the matching EndWindowBatch are registered immediately,
+	 * but attached to the viewport (ordered by layer) and initialized only when the outermost batch ends.
+	 * C++ only, prefer FScopedWindowBatch. Blueprints batch through OpenWindows and CloseWindows.
+	 * A batch still open at the end of the frame is committed with an error.
+	 */
+	void BeginWindowBatch();
+	void EndWindowBatch();
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	bool IsInWindowBatch() const;
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	bool IsOpen(TSubclassOf<UUIView> WindowType) const;
+
+	/**
+	 * Is this instance the open window of its class. False once it is closed, even if another window of the class is opened
+	 */
+	bool IsWindowOpen(const UUIView* Window) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void InitializeExistsView(UUIView* ExistedView);
+
+	/**
+	 * Hints that a window is likely to be opened soon. On idle frames the window is constructed and initialized
+	 * without being attached to the viewport, so a later OpenWindow only attaches the prepared instance.
+	 * A prepared window that is not opened in time is discarded.
+	 * @param WindowType Selected window type
+	 * @param LikelyWithinSeconds How long the hint and the prepared window stay valid
+	 * @param Owner nullptr == Owner is WindowService
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void PrewarmWindow(TSubclassOf<UUIView> WindowType, float LikelyWithinSeconds = 5.f, APlayerController* Owner = nullptr);
+	/**
+	 * Drops a pending hint and discards the prepared window of the selected type, if any.
+	 * @param WindowType Selected window type
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void CancelPrewarm(TSubclassOf<UUIView> WindowType);
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	bool IsPrewarmed(TSubclassOf<UUIView> WindowType) const;
+
+	/**
+	 * Stores a descriptor of the open-window set (classes, layers, owners, hidden state, viewmodel state)
+	 * in the game instance, so it can be rebuilt in another world. Called automatically before travel when
+	 * bRestoreWindowsAfterTravel is enabled in the plugin settings.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void CaptureWindowState();
+	/**
+	 * Rebuilds the stored window set in this world in batches, within a frame budget.
+	 * Called automatically on world begin play when bRestoreWindowsAfterTravel is enabled.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void RestoreWindowState();
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	bool IsRestoringWindows() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void HideAllWindows();
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void ShowAllWindows();
+
+	/**
+	 * C++ variant of CreatePopUp method
+	 * @param PopUpType Selected Pop-up type
+	 * @param Owner - nullptr == Owner is WindowService
+	 * @param ParentWidget Content widget
+	 * @return Needed Pop-up widget
+	 */
+	UFUNCTION()
+	UUIPopUpView* CreatePopUp(TSubclassOf<UUIPopUpView> PopUpType, APlayerController* Owner = nullptr, UPanelWidget* ParentWidget = nullptr);
+
+	/**
+	 * C++ template variant of CreatePopUp method. Auto Cast to T type
+	 * @tparam T Inheritor of UUIPopUpView class
+	 * @param Owner nullptr == Owner is WindowService
+	 * @param ParentWidget Content widget
+	 * @return Needed Pop-up widget
+	 */
+	template<class T = UUIPopUpView>
+	T* CreatePopUp(TSubclassOf<UUIPopUpView> PopUpType, APlayerController* Owner = nullptr, UPanelWidget* ParentWidget = nullptr)
+	{
+		static_assert(TIsDerivedFrom<T, UUIPopUpView>::IsDerived, "CreatePopUp can only be used to create UUIPopUpView instances");
+		
+		check(IsValid(PopUpType) && (PopUpType->IsChildOf(T::StaticClass()) || PopUpType == T::StaticClass()));
+		
+		return Cast<T>(CreatePopUp(MoveTemp(PopUpType), Owner, ParentWidget));
+	}
+
+	/**
+	 * Shows a notification pop-up through the notification queue instead of creating it directly.
+	 * A notification with the same key as a shown or queued one is merged into it and increases its count.
+	 * Pop-ups over the MaxConcurrentNotifications of their class wait in the queue, ordered by priority,
+	 * and at most MaxNotificationSpawnsPerFrame pop-ups are created per frame.
+	 * @param PopUpType Selected Pop-up type
+	 * @param Key Coalescing key. NAME_None never coalesces
+	 * @param Priority Higher priority notifications leave the queue first
+	 * @param Payload Data passed to InitializeNotification and OnNotificationCoalesced
+	 * @param Owner nullptr == Owner is WindowService
+	 * @param ParentWidget Content widget
+	 * @return Shown pop-up the notification was spawned in or merged into. nullptr if it was queued or dropped
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	UUIPopUpView* PushNotification(UPARAM(meta=(AllowAbstract=false))TSubclassOf<UUIPopUpView> PopUpType, FName Key = NAME_None, int32 Priority = 0,
+		UObject* Payload = nullptr, APlayerController* Owner = nullptr, UPanelWidget* ParentWidget = nullptr);
+
+	/**
+	 * Drops every queued notification. Shown pop-ups are not affected
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	void ClearNotificationQueue();
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "MVVM|WindowSubsystem")
+	int32 GetQueuedNotificationCount() const;
+
+private:
+
+	UModelRepositorySubsystem* GetModelRepository() const;
+	UWorldModelRepositorySubsystem* GetWorldModelRepository() const;
+
+	UUIView* CreateWindow(const TSubclassOf<UUIView>& WindowType, APlayerController* Owner) const;
+	UUIPopUpView* SpawnPopUp(const TSubclassOf<UUIPopUpView>& PopUpType, APlayerController* Owner, UPanelWidget* ParentWidget) const;
+
+	void AttachWindow(UUIView* Window);
+	void CommitWindowBatch();
+
+	void OnPreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
+	void OnSeamlessTravelStart(UWorld* World, const FString& MapName);
+	void ProcessWindowRestore();
+	APlayerController* FindLocalPlayerController(int32 LocalPlayerIndex) const;
+	UWindowStateSubsystem* GetWindowStateSubsystem() const;
+
+	void ProcessPrewarmHints();
+	void PrepareWindow(const FWindowPrewarmHint& Hint);
+	void DiscardExpiredPrewarmedWindows();
+
+	/**
+	 * Removes a prepared window from the prewarm storage.
+	 * @param WindowType Selected window type
+	 * @param Owner Requested owner. A window prepared for another player is discarded
+	 * @param OutSlateWidget Keeps the prebuilt Slate widget alive until the window is attached
+	 * @return Prepared window or nullptr
+	 */
+	UUIView* TakePrewarmedWindow(UClass* WindowType, APlayerController* Owner, TSharedPtr<SWidget>& OutSlateWidget);
+
+	UUIViewModel* FindSharedViewModel(const UClass* ViewModelType, const UObject* Context) const;
+	void RegisterSharedViewModel(UUIViewModel* ViewModel, const UObject* Context);
+	void UnregisterSharedViewModel(UUIViewModel* ViewModel);
+
+	void RegisterLODView(UUIView* View);
+	void UnregisterLODView(UUIView* View);
+
+	/**
+	 * Picks the LOD tier of every actor-bound view and updates the viewmodels whose interval has elapsed. One pass per frame.
+	 */
+	void ProcessViewLOD(float DeltaTime);
+
+	UUIViewModel* TakePooledViewModel(UClass* ViewModelType);
+	void ReturnViewModelToPool(UUIViewModel* ViewModel);
+
+	bool HasNotificationCapacity(UClass* PopUpType) const;
+	bool HasNotificationSpawnBudget();
+	void EnqueueNotification(FPendingNotification&& Notification);
+	UUIPopUpView* SpawnNotification(FPendingNotification& Notification);
+
+	/**
+	 * Spawns queued notifications that have a free slot, within the per-frame budget.
+	 */
+	void ProcessNotificationQueue();
+	void OnNotificationDestroyed(UUIPopUpView* PopUp);
+
+	/**
+	 * Starts or moves the lifespan of a pop-up.
+	 * @param PopUp Pop-up removed when the lifespan ends
+	 * @param Seconds Lifespan from now
+	 */
+	void SchedulePopUpLifeSpan(UUIPopUpView* PopUp, float Seconds);
+	void CancelPopUpLifeSpan(FPopUpTimerHandle& Handle);
+	float GetPopUpRemainingLifeSpan(const FPopUpTimerHandle& Handle) const;
+
+	/**
+	 * Advances the timing wheel and releases every pop-up whose lifespan ended this frame in one batch.
+	 */
+	void ProcessPopUpLifeSpans();
+
+	void RegisterCoroutineOwner(UUIViewModel* ViewModel);
+
+	/**
+	 * Resumes the coroutines of every viewmodel that has some running.
+	 */
+	void ProcessViewModelCoroutines();
+
+	/**
+	 * @return Queue the results of the channel are pushed to
+	 */
+	TSharedRef<FDerivedViewDataQueue, ESPMode::ThreadSafe> RegisterDerivedViewData(const TSharedRef<FDerivedViewDataChannel, ESPMode::ThreadSafe>& Channel);
+
+	/**
+	 * Requests transforms for new input snapshots and applies the latest finished results in one batch.
+	 */
+	void ProcessDerivedViewData();
+
+	friend class UUIView;
+	friend class UUIViewModel;
+	friend class UUIPopUpView;
+	friend class FDerivedViewDataChannel;
+};
+
+/**
+ * Keeps a window batch open for the lifetime of the scope.
+ */
+struct FScopedWindowBatch
+{
+	explicit FScopedWindowBatch(UWindowSubsystem* InWindowSubsystem)
+		: WindowSubsystem(InWindowSubsystem)
+	{
+		if(WindowSubsystem.IsValid())
+		{
+			WindowSubsystem->BeginWindowBatch();
+		}
+	}
+
+	~FScopedWindowBatch()
+	{
+		if(WindowSubsystem.IsValid())
+		{
+			WindowSubsystem->EndWindowBatch();
+		}
+	}
+
+	UE_NONCOPYABLE(FScopedWindowBatch);
+
+private:
+	
+	TWeakObjectPtr<UWindowSubsystem> WindowSubsystem;
+};